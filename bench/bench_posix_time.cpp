@@ -0,0 +1,467 @@
+/*
+  Benchmarks of the main functions of the library, on arrays of random posix times.
+
+  This is also the training workload for the profile guided optimization build (see the pgo_train target in
+  CMakeLists.txt), so it should cover the functions in the proportions in which they are used in practice.
+
+  usage: kiss_posix_time_bench [n_repetitions]
+  for each benchmark, the best time over n_repetitions runs (default 5) is reported, in nanoseconds per value; the
+  decoders also report their throughput, in bytes (of encoded input, and of decoded output) per second.
+*/
+
+#include "kiss_posix_time.hpp"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <time.h>
+#include <vector>
+
+// number of values each benchmark works on; small enough to stay in cache
+static constexpr size_t BENCH_N_VALUES = 1 << 16;
+
+// the RFC 1123 layout, as a compile time pattern for kiss_posix_time_fixed_format
+static constexpr char bench_rfc1123_pattern[] = "%a, %d %b %Y %H:%M:%S GMT";
+
+// whatever the benchmarks compute ends up here, so that the compiler cannot remove it
+static uint64_t bench_sink {0};
+
+// a simple xorshift generator, so that the workload is the same on all platforms
+static uint64_t bench_random(uint64_t *const state){
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// run function n_repetitions times, and print and return the best time per value, in nanoseconds
+template <typename Function>
+static double bench_run(char const *const name, size_t const n_repetitions, size_t const n_values, Function function){
+    double best_ns {0.0};
+
+    for (size_t repetition=0; repetition<n_repetitions; repetition++){
+        auto const start = std::chrono::steady_clock::now();
+        function();
+        auto const end = std::chrono::steady_clock::now();
+        double const ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        if (repetition == 0 || ns < best_ns){
+            best_ns = ns;
+        }
+    }
+
+    printf("%-40s %10.2f ns/value\n", name, best_ns / static_cast<double>(n_values));
+    return best_ns / static_cast<double>(n_values);
+}
+
+// print the throughput of a decoder, from its time per value, in GB per second of encoded input and of decoded output
+static void bench_print_throughput(char const *const name, double const ns_per_value, size_t const encoded_size, size_t const n_values){
+    double const encoded_bytes_per_value = static_cast<double>(encoded_size) / static_cast<double>(n_values);
+    printf("%-40s %10.2f GB/s in, %.2f GB/s out\n", name, encoded_bytes_per_value / ns_per_value,
+           static_cast<double>(sizeof(kiss_time_t)) / ns_per_value);
+}
+
+int main(int argc, char **argv){
+    size_t n_repetitions {5};
+    if (argc > 1){
+        n_repetitions = static_cast<size_t>(strtoull(argv[1], nullptr, 10));
+    }
+    if (n_repetitions == 0){
+        n_repetitions = 1;
+    }
+
+    // random posix times between 1970 and 2100, and the same values sorted as a regular series
+    uint64_t random_state {0x2545F4914F6CDD1D};
+    std::vector<kiss_time_t> posix(BENCH_N_VALUES);
+    std::vector<kiss_time_t> series(BENCH_N_VALUES);
+    for (size_t i=0; i<BENCH_N_VALUES; i++){
+        posix[i] = bench_random(&random_state) % 4102444800;
+        series[i] = 1600000000 + 60 * i + bench_random(&random_state) % 3;
+    }
+
+    std::vector<kiss_calendar_time> calendars(BENCH_N_VALUES);
+    posix_to_calendar_batch(posix.data(), calendars.data(), BENCH_N_VALUES);
+
+    std::vector<kiss_time_t> posix_out(BENCH_N_VALUES);
+    std::vector<kiss_calendar_time> calendars_out(BENCH_N_VALUES);
+    std::vector<uint8_t> mask(BENCH_N_VALUES);
+    std::vector<uint8_t> encoded(for_max_encoded_size(BENCH_N_VALUES) + 16 * BENCH_N_VALUES);
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // core conversions
+
+    bench_run("posix_to_calendar", n_repetitions, BENCH_N_VALUES, [&](){
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            posix_to_calendar(posix[i], &calendars_out[i]);
+        }
+        bench_sink += calendars_out[BENCH_N_VALUES - 1].second;
+    });
+
+    bench_run("calendar_to_posix", n_repetitions, BENCH_N_VALUES, [&](){
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            posix_out[i] = calendar_to_posix(&calendars[i]);
+        }
+        bench_sink += posix_out[BENCH_N_VALUES - 1];
+    });
+
+    bench_run("posix_to_calendar_batch", n_repetitions, BENCH_N_VALUES, [&](){
+        posix_to_calendar_batch(posix.data(), calendars_out.data(), BENCH_N_VALUES);
+        bench_sink += calendars_out[BENCH_N_VALUES - 1].second;
+    });
+
+    // ordinal dates, through the calendar and the tables of cumulative days, or directly
+    std::vector<kiss_ordinal_date> ordinals(BENCH_N_VALUES);
+    bench_run("ordinal_through_calendar", n_repetitions, BENCH_N_VALUES, [&](){
+        posix_to_calendar_batch(posix.data(), calendars_out.data(), BENCH_N_VALUES);
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            kiss_calendar_time const *const calendar = &calendars_out[i];
+            uint16_t const *const cumulative_days = is_leap_year(calendar->year) ? cumulative_days_per_month_leap : cumulative_days_per_month_normal;
+            ordinals[i] = kiss_ordinal_date {calendar->year, static_cast<uint16_t>(cumulative_days[calendar->month - 1] + calendar->day)};
+        }
+        bench_sink += ordinals[BENCH_N_VALUES - 1].day_of_year;
+    });
+
+    bench_run("posix_to_ordinal_batch", n_repetitions, BENCH_N_VALUES, [&](){
+        posix_to_ordinal_batch(posix.data(), ordinals.data(), BENCH_N_VALUES);
+        bench_sink += ordinals[BENCH_N_VALUES - 1].day_of_year;
+    });
+
+    bench_run("posix_to_modified_julian_day_batch", n_repetitions, BENCH_N_VALUES, [&](){
+        posix_to_modified_julian_day_batch(posix.data(), posix_out.data(), BENCH_N_VALUES);
+        bench_sink += posix_out[BENCH_N_VALUES - 1];
+    });
+
+    bench_run("calendar_to_posix_batch", n_repetitions, BENCH_N_VALUES, [&](){
+        calendar_to_posix_batch(calendars.data(), posix_out.data(), BENCH_N_VALUES);
+        bench_sink += posix_out[BENCH_N_VALUES - 1];
+    });
+
+    bench_run("calendar_to_posix_checked_batch", n_repetitions, BENCH_N_VALUES, [&](){
+        bench_sink += calendar_to_posix_checked_batch(calendars.data(), posix_out.data(), BENCH_N_VALUES, mask.data());
+    });
+
+    bench_run("calendar_is_valid_batch", n_repetitions, BENCH_N_VALUES, [&](){
+        bench_sink += calendar_is_valid_batch(calendars.data(), BENCH_N_VALUES, mask.data());
+    });
+
+    bench_run("posix_to_wide_calendar", n_repetitions, BENCH_N_VALUES, [&](){
+        kiss_wide_calendar_time wide_calendar;
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            posix_to_wide_calendar(posix[i], &wide_calendar);
+            bench_sink += wide_calendar.day;
+        }
+    });
+
+    // a fixed cadence series, by conversion of each time, and by stepping the calendar
+    bench_run("posix_to_calendar_fixed_step", n_repetitions, BENCH_N_VALUES, [&](){
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            posix_to_calendar(1600000000 + 90 * i, &calendars_out[i]);
+        }
+        bench_sink += calendars_out[BENCH_N_VALUES - 1].second;
+    });
+
+    bench_run("calendar_fill_steps", n_repetitions, BENCH_N_VALUES, [&](){
+        bench_sink += calendar_fill_steps(&calendars[0], 90, calendars_out.data(), BENCH_N_VALUES);
+    });
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // extras
+
+    bench_run("print_iso", n_repetitions, BENCH_N_VALUES, [&](){
+        char buffer[20];
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            print_iso(posix[i], buffer, 20);
+            bench_sink += static_cast<uint8_t>(buffer[18]);
+        }
+    });
+
+    // sorted log timestamps, a few lines per second
+    std::vector<kiss_time_t> log_times(BENCH_N_VALUES);
+    for (size_t i=0; i<BENCH_N_VALUES; i++){
+        log_times[i] = 1638795207 + i / 3;
+    }
+
+    bench_run("print_iso_sorted", n_repetitions, BENCH_N_VALUES, [&](){
+        char buffer[20];
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            print_iso(log_times[i], buffer, 20);
+            bench_sink += static_cast<uint8_t>(buffer[18]);
+        }
+    });
+
+    bench_run("iso_formatter_sorted", n_repetitions, BENCH_N_VALUES, [&](){
+        kiss_iso_formatter formatter;
+        iso_formatter_init(&formatter);
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            bench_sink += static_cast<uint8_t>(iso_formatter_print(&formatter, log_times[i])[18]);
+        }
+    });
+
+    // the usual export path: print_iso to a small buffer, then a copy into a std::string per row
+    std::vector<std::string> strings(BENCH_N_VALUES);
+    bench_run("print_iso_to_strings", n_repetitions, BENCH_N_VALUES, [&](){
+        char buffer[20];
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            print_iso(posix[i], buffer, 20);
+            strings[i] = std::string(buffer, 19);
+        }
+        bench_sink += static_cast<uint8_t>(strings[BENCH_N_VALUES - 1][18]);
+    });
+
+    // room for the longest strings of the arena benchmarks, the RFC 3339 ones with milliseconds
+    std::vector<char> slab(24 * BENCH_N_VALUES);
+    std::vector<kiss_text_view> views(BENCH_N_VALUES);
+    kiss_text_arena arena;
+    text_arena_init(&arena, slab.data(), slab.size());
+    bench_run("print_iso_arena", n_repetitions, BENCH_N_VALUES, [&](){
+        text_arena_clear(&arena);
+        bench_sink += print_iso_arena(posix.data(), BENCH_N_VALUES, &arena, views.data());
+    });
+
+    // the two steps that print_rfc3339 replaces: print_iso, then appending the fraction and the 'Z'
+    bench_run("print_iso_then_fraction", n_repetitions, BENCH_N_VALUES, [&](){
+        char buffer[32];
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            print_iso(posix[i], buffer, 32);
+            bench_sink += static_cast<uint64_t>(snprintf(buffer + 19, 13, ".%03uZ", static_cast<unsigned>(i % 1000)));
+        }
+    });
+
+    kiss_rfc3339_options const rfc3339_milliseconds {3, 0};
+    bench_run("print_rfc3339", n_repetitions, BENCH_N_VALUES, [&](){
+        char buffer[32];
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            bench_sink += print_rfc3339(posix[i], static_cast<uint32_t>(i % 1000) * 1000000, &rfc3339_milliseconds, buffer, 32);
+        }
+    });
+
+    bench_run("print_rfc3339_arena", n_repetitions, BENCH_N_VALUES, [&](){
+        text_arena_clear(&arena);
+        bench_sink += print_rfc3339_arena(posix.data(), nullptr, BENCH_N_VALUES, &rfc3339_milliseconds, &arena, views.data());
+    });
+
+    bench_run("day_of_week", n_repetitions, BENCH_N_VALUES, [&](){
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            bench_sink += day_of_week(posix[i]);
+        }
+    });
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // format
+
+    bench_run("strftime_rfc1123", n_repetitions, BENCH_N_VALUES, [&](){
+        char buffer[64];
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            time_t const time_in = static_cast<time_t>(posix[i]);
+            struct tm broken_down;
+            gmtime_r(&time_in, &broken_down);
+            bench_sink += strftime(buffer, 64, "%a, %d %b %Y %H:%M:%S GMT", &broken_down);
+        }
+    });
+
+    kiss_format_program rfc1123;
+    format_compile("%a, %d %b %Y %H:%M:%S GMT", &rfc1123);
+    bench_run("format_print_rfc1123", n_repetitions, BENCH_N_VALUES, [&](){
+        char buffer[64];
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            bench_sink += format_print(&rfc1123, posix[i], buffer, 64);
+        }
+    });
+
+    // the same times as "%Y%m%d%H%M%S" lines, parsed back
+    kiss_format_program compact;
+    format_compile("%Y%m%d%H%M%S", &compact);
+    std::string lines;
+    for (size_t i=0; i<BENCH_N_VALUES; i++){
+        char buffer[64];
+        lines.append(buffer, format_print(&compact, posix[i], buffer, 64));
+        lines.push_back('\n');
+    }
+    std::vector<kiss_time_t> parsed(BENCH_N_VALUES);
+    std::vector<uint8_t> parsed_mask(BENCH_N_VALUES / 8);
+
+    bench_run("sscanf_compact", n_repetitions, BENCH_N_VALUES, [&](){
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            // a copy of the line, as sscanf would otherwise go through the whole rest of the buffer
+            char line[16] {};
+            lines.copy(line, 14, 15 * i);
+            unsigned year, month, day, hour, minute, second;
+            sscanf(line, "%4u%2u%2u%2u%2u%2u", &year, &month, &day, &hour, &minute, &second);
+            kiss_calendar_time const calendar {static_cast<uint16_t>(year), static_cast<uint8_t>(month), static_cast<uint8_t>(day),
+                                               static_cast<uint8_t>(hour), static_cast<uint8_t>(minute), static_cast<uint8_t>(second)};
+            calendar_to_posix_checked(&calendar, &parsed[i]);
+        }
+        bench_sink += parsed[0];
+    });
+
+    bench_run("format_parse_lines_compact", n_repetitions, BENCH_N_VALUES, [&](){
+        size_t n_bytes {0};
+        bench_sink += format_parse_lines(&compact, lines.data(), lines.size(), parsed.data(), parsed_mask.data(), BENCH_N_VALUES, &n_bytes);
+        bench_sink += parsed[0];
+    });
+
+    // the same times as epoch seconds lines
+    std::string epoch_lines;
+    for (size_t i=0; i<BENCH_N_VALUES; i++){
+        char buffer[32];
+        epoch_lines.append(buffer, print_epoch(posix[i], buffer, 32));
+        epoch_lines.push_back('\n');
+    }
+    std::vector<kiss_calendar_time> parsed_calendars(BENCH_N_VALUES);
+
+    bench_run("strtoull_posix_to_calendar", n_repetitions, BENCH_N_VALUES, [&](){
+        char const *position = epoch_lines.data();
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            char *end;
+            posix_to_calendar(strtoull(position, &end, 10), &parsed_calendars[i]);
+            position = end + 1;
+        }
+        bench_sink += parsed_calendars[0].second;
+    });
+
+    bench_run("strtoull", n_repetitions, BENCH_N_VALUES, [&](){
+        char const *position = epoch_lines.data();
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            char *end;
+            parsed[i] = strtoull(position, &end, 10);
+            position = end + 1;
+        }
+        bench_sink += parsed[0];
+    });
+
+    bench_run("parse_epoch_lines", n_repetitions, BENCH_N_VALUES, [&](){
+        size_t n_bytes {0};
+        bench_sink += parse_epoch_lines(epoch_lines.data(), epoch_lines.size(), parsed.data(), parsed_mask.data(), BENCH_N_VALUES, &n_bytes);
+        bench_sink += parsed[0];
+    });
+
+    bench_run("parse_epoch_lines_calendar", n_repetitions, BENCH_N_VALUES, [&](){
+        size_t n_bytes {0};
+        bench_sink += parse_epoch_lines(epoch_lines.data(), epoch_lines.size(), parsed_calendars.data(), parsed_mask.data(), BENCH_N_VALUES, &n_bytes);
+        bench_sink += parsed_calendars[0].second;
+    });
+
+    bench_run("snprintf_epoch", n_repetitions, BENCH_N_VALUES, [&](){
+        char buffer[32];
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            bench_sink += static_cast<uint64_t>(snprintf(buffer, 32, "%llu", static_cast<unsigned long long>(posix[i])));
+        }
+    });
+
+    bench_run("print_epoch", n_repetitions, BENCH_N_VALUES, [&](){
+        char buffer[32];
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            bench_sink += print_epoch(posix[i], buffer, 32);
+        }
+    });
+
+    bench_run("fixed_format_print_rfc1123", n_repetitions, BENCH_N_VALUES, [&](){
+        char buffer[64];
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            fixed_format_print<bench_rfc1123_pattern>(posix[i], buffer);
+            bench_sink += static_cast<uint8_t>(buffer[5]);
+        }
+    });
+
+    bench_run("fixed_format_print_iso", n_repetitions, BENCH_N_VALUES, [&](){
+        char buffer[64];
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            fixed_format_print<KISS_FIXED_FORMAT_ISO>(posix[i], buffer);
+            bench_sink += static_cast<uint8_t>(buffer[5]);
+        }
+    });
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // series
+
+    bench_run("histogram_month", n_repetitions, BENCH_N_VALUES, [&](){
+        uint64_t counts[12] {};
+        histogram_month(posix.data(), BENCH_N_VALUES, counts);
+        bench_sink += counts[0];
+    });
+
+    bench_run("sorted_lower_bound", n_repetitions, BENCH_N_VALUES, [&](){
+        for (size_t i=0; i<BENCH_N_VALUES; i++){
+            bench_sink += sorted_lower_bound(series.data(), BENCH_N_VALUES, posix[i] % (60 * BENCH_N_VALUES) + 1600000000);
+        }
+    });
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // compression
+
+    size_t dod_size {0};
+    bench_run("dod_encode", n_repetitions, BENCH_N_VALUES, [&](){
+        dod_size = dod_encode(series.data(), BENCH_N_VALUES, 1024, encoded.data(), encoded.size());
+        bench_sink += dod_size;
+    });
+
+    bench_run("dod_decode", n_repetitions, BENCH_N_VALUES, [&](){
+        bench_sink += dod_decode(encoded.data(), dod_size, posix_out.data(), BENCH_N_VALUES);
+    });
+
+    size_t for_size {0};
+    bench_run("for_encode", n_repetitions, BENCH_N_VALUES, [&](){
+        for_size = for_encode(series.data(), BENCH_N_VALUES, encoded.data(), encoded.size());
+        bench_sink += for_size;
+    });
+
+    double const for_decode_ns = bench_run("for_decode", n_repetitions, BENCH_N_VALUES, [&](){
+        bench_sink += for_decode(encoded.data(), for_size, posix_out.data(), BENCH_N_VALUES);
+    });
+    bench_print_throughput("for_decode_throughput", for_decode_ns, for_size, BENCH_N_VALUES);
+
+    bench_run("for_decode_to_calendar", n_repetitions, BENCH_N_VALUES, [&](){
+        bench_sink += for_decode_to_calendar(encoded.data(), for_size, calendars_out.data(), BENCH_N_VALUES);
+    });
+
+    // random times, i.e. wide offsets, about 32 bits each
+    size_t const for_random_size = for_encode(posix.data(), BENCH_N_VALUES, encoded.data(), encoded.size());
+    double const for_decode_random_ns = bench_run("for_decode_random", n_repetitions, BENCH_N_VALUES, [&](){
+        bench_sink += for_decode(encoded.data(), for_random_size, posix_out.data(), BENCH_N_VALUES);
+    });
+    bench_print_throughput("for_decode_random_throughput", for_decode_random_ns, for_random_size, BENCH_N_VALUES);
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // schedules
+
+    size_t const n_cron_values = BENCH_N_VALUES / 16;
+    kiss_cron_rule rule;
+    cron_compile("30 2 * * 1-5", &rule);
+    bench_run("cron_next_fire_after", n_repetitions, n_cron_values, [&](){
+        kiss_time_t next;
+        for (size_t i=0; i<n_cron_values; i++){
+            cron_next_fire_after(&rule, posix[i], &next);
+            bench_sink += next;
+        }
+    });
+
+    bench_run("schedule_fill_monthly_nth_week_day", n_repetitions, n_cron_values, [&](){
+        kiss_schedule_iterator iterator;
+        schedule_init_monthly_nth_week_day(&iterator, 0, 1, 1, 8, 0, 0);
+        schedule_fill(&iterator, posix_out.data(), n_cron_values);
+        bench_sink += posix_out[n_cron_values - 1];
+    });
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // backends
+
+    backend_calibrate(n_repetitions);
+    kiss_backend_report report;
+    backend_report(&report);
+    for (uint8_t backend=0; backend<KISS_N_BACKENDS; backend++){
+        printf("backend %-5s posix_to_calendar %8.2f ns/value, calendar_to_posix %8.2f ns/value\n", backend_name(backend),
+               static_cast<double>(report.posix_to_calendar_ns[backend]) / static_cast<double>(KISS_BACKEND_CALIBRATION_SIZE),
+               static_cast<double>(report.calendar_to_posix_ns[backend]) / static_cast<double>(KISS_BACKEND_CALIBRATION_SIZE));
+    }
+    printf("fastest backends on this host: posix_to_calendar %s, calendar_to_posix %s\n",
+           backend_name(report.posix_to_calendar_backend), backend_name(report.calendar_to_posix_backend));
+
+    bench_run("backend_posix_to_calendar_batch", n_repetitions, BENCH_N_VALUES, [&](){
+        backend_posix_to_calendar_batch(posix.data(), calendars_out.data(), BENCH_N_VALUES);
+        bench_sink += calendars_out[BENCH_N_VALUES - 1].second;
+    });
+
+    printf("(checksum %llu)\n", static_cast<unsigned long long>(bench_sink));
+
+    return 0;
+}
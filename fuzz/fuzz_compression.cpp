@@ -0,0 +1,54 @@
+/*
+  Fuzz target for the compression codecs: the decoders must reject or decode any buffer without reading or writing
+  out of bounds, and the input read as a series of posix times must go through an encode / decode round trip.
+*/
+
+#include "kiss_posix_time.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+static constexpr size_t FUZZ_MAX_VALUES = 1024;
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const *data, size_t size){
+    static kiss_time_t values[FUZZ_MAX_VALUES];
+    static kiss_time_t values_out[FUZZ_MAX_VALUES];
+    static kiss_calendar_time calendars_out[FUZZ_MAX_VALUES];
+    static uint8_t encoded[16 * FUZZ_MAX_VALUES + 1024];
+
+    // decoding arbitrary bytes
+    dod_decode(data, size, values_out, FUZZ_MAX_VALUES);
+    for_decode(data, size, values_out, FUZZ_MAX_VALUES);
+    for_decode_to_calendar(data, size, calendars_out, FUZZ_MAX_VALUES);
+    dod_decode_stream(data, size, size / 8, values_out);
+
+    // round trips; the values are kept in the range of kiss_calendar_time for for_decode_to_calendar
+    size_t const n_values = size / 8;
+    for (size_t i=0; i<n_values; i++){
+        memcpy(&values[i], &data[8 * i], sizeof(kiss_time_t));
+        values[i] %= 2005949145600;
+    }
+
+    size_t const block_length = (size > 0) ? data[0] % 16 + 1 : 1;
+    size_t const dod_size = dod_encode(values, n_values, block_length, encoded, sizeof(encoded));
+    if (dod_size == 0 || dod_decode(encoded, dod_size, values_out, FUZZ_MAX_VALUES) != n_values){
+        if (n_values != 0){
+            abort();
+        }
+    }
+    if (memcmp(values, values_out, n_values * sizeof(kiss_time_t)) != 0){
+        abort();
+    }
+
+    size_t const for_size = for_encode(values, n_values, encoded, sizeof(encoded));
+    if (for_size == 0 || for_decode(encoded, for_size, values_out, FUZZ_MAX_VALUES) != n_values){
+        if (n_values != 0){
+            abort();
+        }
+    }
+    if (memcmp(values, values_out, n_values * sizeof(kiss_time_t)) != 0){
+        abort();
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+/*
+  Fuzz target for the core conversions: any 7 bytes are a calendar to check and convert, and any 8 bytes are a
+  posix time to convert and convert back. Aborts if a round trip does not give back the input.
+*/
+
+#include "kiss_posix_time.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const *data, size_t size){
+    if (size >= 7){
+        kiss_calendar_time calendar;
+        calendar.year = static_cast<uint16_t>(data[0] | (data[1] << 8));
+        calendar.month = data[2];
+        calendar.day = data[3];
+        calendar.hour = data[4];
+        calendar.minute = data[5];
+        calendar.second = data[6];
+
+        kiss_time_t posix;
+        if (calendar_to_posix_checked(&calendar, &posix) == KISS_CONVERSION_OK){
+            kiss_calendar_time calendar_out;
+            posix_to_calendar(posix, &calendar_out);
+            bool const same_calendar = calendar_out.year == calendar.year && calendar_out.month == calendar.month
+                                       && calendar_out.day == calendar.day && calendar_out.hour == calendar.hour
+                                       && calendar_out.minute == calendar.minute && calendar_out.second == calendar.second;
+            if (!same_calendar || !calendar_is_valid(&calendar)){
+                abort();
+            }
+        }
+        else if (calendar_is_valid(&calendar)){
+            abort();
+        }
+    }
+
+    if (size >= 8){
+        kiss_time_t posix {0};
+        memcpy(&posix, data, sizeof(kiss_time_t));
+        posix %= LAST_POSIX_IN_CALENDAR_TIME + 1;
+
+        kiss_calendar_time calendar;
+        posix_to_calendar(posix, &calendar);
+        if (calendar_to_posix(&calendar) != posix){
+            abort();
+        }
+
+        kiss_wide_calendar_time wide_calendar;
+        kiss_time_t wide_posix;
+        posix_to_wide_calendar(posix, &wide_calendar);
+        if (!wide_calendar_to_posix(&wide_calendar, &wide_posix) || wide_posix != posix){
+            abort();
+        }
+
+        char buffer[20];
+        print_iso(posix, buffer, 20);
+        if (strlen(buffer) != 19){
+            abort();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+/*
+  Fuzz target for the cron expressions: any string is either rejected by cron_compile, or gives a rule such that
+  the next fire time, if any, matches the rule.
+*/
+
+#include "kiss_posix_time.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+static constexpr size_t FUZZ_MAX_EXPRESSION_LENGTH = 128;
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const *data, size_t size){
+    // random bytes rarely give a valid expression, so the bytes are also mapped to the cron characters
+    static char const alphabet[] = "0123456789*,-/ 15";
+    char expression[FUZZ_MAX_EXPRESSION_LENGTH + 1];
+    char mapped_expression[FUZZ_MAX_EXPRESSION_LENGTH + 1];
+    size_t const length = (size < FUZZ_MAX_EXPRESSION_LENGTH) ? size : FUZZ_MAX_EXPRESSION_LENGTH;
+    for (size_t i=0; i<length; i++){
+        expression[i] = static_cast<char>(data[i]);
+        mapped_expression[i] = alphabet[data[i] % (sizeof(alphabet) - 1)];
+    }
+    expression[length] = '\0';
+    mapped_expression[length] = '\0';
+
+    char const *const expressions[] = {expression, mapped_expression};
+    for (char const *const current_expression : expressions){
+        kiss_cron_rule rule;
+        if (!cron_compile(current_expression, &rule)){
+            continue;
+        }
+
+        kiss_time_t const start = (size >= 4) ? static_cast<kiss_time_t>(data[0] | (data[1] << 8) | (data[2] << 16)) * 4099 : 0;
+        kiss_time_t next;
+        if (cron_next_fire_after(&rule, start, &next)){
+            if (next <= start || next % 60 != 0 || !cron_matches(&rule, next)){
+                abort();
+            }
+        }
+    }
+
+    return 0;
+}
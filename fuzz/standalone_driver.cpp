@@ -0,0 +1,57 @@
+/*
+  Driver for the fuzz targets when libFuzzer is not available (for example with GCC): run the fuzz target on each
+  file given as argument, or, without arguments, on a fixed sequence of pseudo random inputs. This does not
+  explore the inputs like libFuzzer does, but is enough to run the fuzz targets as tests, for example under the
+  sanitizers.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const *data, size_t size);
+
+static constexpr size_t DRIVER_N_RANDOM_INPUTS = 200000;
+static constexpr size_t DRIVER_MAX_INPUT_SIZE = 256;
+
+int main(int argc, char **argv){
+    if (argc > 1){
+        for (int i=1; i<argc; i++){
+            FILE *const file = fopen(argv[i], "rb");
+            if (file == nullptr){
+                printf("cannot open %s\n", argv[i]);
+                return 1;
+            }
+            std::vector<uint8_t> input;
+            int c;
+            while ((c = fgetc(file)) != EOF){
+                input.push_back(static_cast<uint8_t>(c));
+            }
+            fclose(file);
+            LLVMFuzzerTestOneInput(input.data(), input.size());
+        }
+        printf("ran %d inputs\n", argc - 1);
+        return 0;
+    }
+
+    // xorshift, so that the inputs are the same on all platforms
+    uint64_t state {0x9E3779B97F4A7C15};
+    uint8_t input[DRIVER_MAX_INPUT_SIZE];
+    for (size_t n=0; n<DRIVER_N_RANDOM_INPUTS; n++){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        size_t const size = state % (DRIVER_MAX_INPUT_SIZE + 1);
+        uint64_t byte_state {state};
+        for (size_t i=0; i<size; i++){
+            byte_state ^= byte_state << 13;
+            byte_state ^= byte_state >> 7;
+            byte_state ^= byte_state << 17;
+            input[i] = static_cast<uint8_t>(byte_state);
+        }
+        LLVMFuzzerTestOneInput(input, size);
+    }
+    printf("ran %zu random inputs\n", DRIVER_N_RANDOM_INPUTS);
+    return 0;
+}
@@ -0,0 +1,25 @@
+#ifndef KISS_POSIX_TIME
+#define KISS_POSIX_TIME
+
+/*
+
+Single include for the whole library. With KISS_POSIX_TIME_HEADER_ONLY defined, this is all that is needed to use
+the library, see kiss_posix_time_config.hpp .
+
+*/
+
+#include "kiss_posix_time_config.hpp"
+#include "kiss_posix_time_utils.hpp"
+#include "kiss_posix_time_extras.hpp"
+#include "kiss_posix_time_schedule.hpp"
+#include "kiss_posix_time_compression.hpp"
+#include "kiss_posix_time_series.hpp"
+#include "kiss_posix_time_c_api.h"
+#include "kiss_posix_time_backends.hpp"
+#include "kiss_posix_time_instrumentation.hpp"
+#include "kiss_posix_time_clock.hpp"
+#include "kiss_posix_time_format.hpp"
+#include "kiss_posix_time_fixed_format.hpp"
+#include "kiss_posix_time_decimal.hpp"
+
+#endif
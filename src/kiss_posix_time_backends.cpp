@@ -0,0 +1,187 @@
+#ifndef KISS_POSIX_TIME_BACKENDS_IMPLEMENTATION
+#define KISS_POSIX_TIME_BACKENDS_IMPLEMENTATION
+
+#include "kiss_posix_time_backends.hpp"
+#include "kiss_posix_time_shared_state.hpp"
+
+#ifndef ARDUINO
+  #include <chrono>
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// internal helpers
+
+using kiss_calendar_to_posix_function = kiss_time_t (*)(kiss_calendar_time const *const);
+using kiss_posix_to_calendar_function = void (*)(kiss_time_t const, kiss_calendar_time *const);
+
+static kiss_calendar_to_posix_function const backends_calendar_to_posix[KISS_N_BACKENDS] =
+    {calendar_to_posix_jr, calendar_to_posix_oryx, calendar_to_posix_era};
+static kiss_posix_to_calendar_function const backends_posix_to_calendar[KISS_N_BACKENDS] =
+    {posix_to_calendar_jr, posix_to_calendar_oryx, posix_to_calendar_era};
+
+// the backend behind calendar_to_posix and posix_to_calendar
+static constexpr uint8_t BACKEND_DEFAULT = USE_JR_IMPLEMENTATION ? KISS_BACKEND_JR : KISS_BACKEND_ORYX;
+
+struct kiss_backend_state
+{
+    kiss_calendar_to_posix_function calendar_to_posix;
+    kiss_posix_to_calendar_function posix_to_calendar;
+    kiss_backend_report report;
+};
+
+// the table of installed backends; it always holds entries of backends_calendar_to_posix and
+// backends_posix_to_calendar, also before any calibration, so that calls through it are the same kind of call
+// (for example, for the instrumentation) whatever the backend
+KISS_POSIX_TIME_INLINE kiss_backend_state *kiss_backend_shared_state(){
+    static kiss_backend_state state {
+        backends_calendar_to_posix[BACKEND_DEFAULT],
+        backends_posix_to_calendar[BACKEND_DEFAULT],
+        {BACKEND_DEFAULT, BACKEND_DEFAULT, false, {0, 0, 0}, {0, 0, 0}}
+    };
+    return &state;
+}
+
+static uint64_t backend_now_ns(){
+    #ifdef ARDUINO
+        return static_cast<uint64_t>(micros()) * 1000;
+    #else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    #endif
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// functions
+
+KISS_POSIX_TIME_INLINE char const *backend_name(uint8_t const backend){
+    switch (backend){
+        case KISS_BACKEND_JR:
+            return "jr";
+        case KISS_BACKEND_ORYX:
+            return "oryx";
+        case KISS_BACKEND_ERA:
+            return "era";
+        default:
+            return "unknown";
+    }
+}
+
+KISS_POSIX_TIME_INLINE void backend_calibrate(size_t const n_rounds){
+    // synthetic sample: spread over 1970 to about 2200, from a fixed xorshift sequence so that all hosts time the same work
+    kiss_time_t posix_sample[KISS_BACKEND_CALIBRATION_SIZE];
+    kiss_calendar_time calendar_sample[KISS_BACKEND_CALIBRATION_SIZE];
+    uint64_t random_state {0x9E3779B97F4A7C15};
+    for (size_t i=0; i<KISS_BACKEND_CALIBRATION_SIZE; i++){
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        posix_sample[i] = random_state % 7258118400;
+        posix_to_calendar(posix_sample[i], &calendar_sample[i]);
+    }
+
+    kiss_backend_state *const state = kiss_backend_shared_state();
+    kiss_backend_report *const report = &state->report;
+    kiss_time_t posix_out[KISS_BACKEND_CALIBRATION_SIZE];
+    kiss_calendar_time calendar_out[KISS_BACKEND_CALIBRATION_SIZE];
+    // accumulate some of the results, so that the compiler cannot drop the conversions
+    volatile uint64_t sink {0};
+
+    for (uint8_t backend=0; backend<KISS_N_BACKENDS; backend++){
+        uint64_t best_calendar_to_posix_ns {UINT64_MAX};
+        uint64_t best_posix_to_calendar_ns {UINT64_MAX};
+
+        for (size_t round=0; round<(n_rounds > 0 ? n_rounds : 1); round++){
+            uint64_t const start = backend_now_ns();
+            for (size_t i=0; i<KISS_BACKEND_CALIBRATION_SIZE; i++){
+                posix_out[i] = backends_calendar_to_posix[backend](&calendar_sample[i]);
+            }
+            uint64_t const middle = backend_now_ns();
+            for (size_t i=0; i<KISS_BACKEND_CALIBRATION_SIZE; i++){
+                backends_posix_to_calendar[backend](posix_sample[i], &calendar_out[i]);
+            }
+            uint64_t const end = backend_now_ns();
+            sink = sink + posix_out[KISS_BACKEND_CALIBRATION_SIZE - 1] + calendar_out[KISS_BACKEND_CALIBRATION_SIZE - 1].second;
+
+            best_calendar_to_posix_ns = (middle - start < best_calendar_to_posix_ns) ? middle - start : best_calendar_to_posix_ns;
+            best_posix_to_calendar_ns = (end - middle < best_posix_to_calendar_ns) ? end - middle : best_posix_to_calendar_ns;
+        }
+
+        // a backend that is fast but wrong on this host is never chosen
+        bool calendar_to_posix_agrees {true};
+        bool posix_to_calendar_agrees {true};
+        for (size_t i=0; i<KISS_BACKEND_CALIBRATION_SIZE; i++){
+            calendar_to_posix_agrees = calendar_to_posix_agrees && (posix_out[i] == posix_sample[i]);
+            posix_to_calendar_agrees = posix_to_calendar_agrees
+                                       && calendar_out[i].year == calendar_sample[i].year && calendar_out[i].month == calendar_sample[i].month
+                                       && calendar_out[i].day == calendar_sample[i].day && calendar_out[i].hour == calendar_sample[i].hour
+                                       && calendar_out[i].minute == calendar_sample[i].minute && calendar_out[i].second == calendar_sample[i].second;
+        }
+
+        report->calendar_to_posix_ns[backend] = calendar_to_posix_agrees ? best_calendar_to_posix_ns : UINT64_MAX;
+        report->posix_to_calendar_ns[backend] = posix_to_calendar_agrees ? best_posix_to_calendar_ns : UINT64_MAX;
+    }
+
+    // the sample was made with the default backends, that always agree with themselves, so there is always a choice
+    uint8_t fastest_calendar_to_posix {BACKEND_DEFAULT};
+    uint8_t fastest_posix_to_calendar {BACKEND_DEFAULT};
+    for (uint8_t backend=0; backend<KISS_N_BACKENDS; backend++){
+        if (report->calendar_to_posix_ns[backend] < report->calendar_to_posix_ns[fastest_calendar_to_posix]){
+            fastest_calendar_to_posix = backend;
+        }
+        if (report->posix_to_calendar_ns[backend] < report->posix_to_calendar_ns[fastest_posix_to_calendar]){
+            fastest_posix_to_calendar = backend;
+        }
+    }
+
+    state->calendar_to_posix = backends_calendar_to_posix[fastest_calendar_to_posix];
+    state->posix_to_calendar = backends_posix_to_calendar[fastest_posix_to_calendar];
+    report->calendar_to_posix_backend = fastest_calendar_to_posix;
+    report->posix_to_calendar_backend = fastest_posix_to_calendar;
+    report->calibrated = true;
+}
+
+KISS_POSIX_TIME_INLINE bool backend_select(uint8_t const posix_to_calendar_backend, uint8_t const calendar_to_posix_backend){
+    if (posix_to_calendar_backend >= KISS_N_BACKENDS || calendar_to_posix_backend >= KISS_N_BACKENDS){
+        return false;
+    }
+
+    kiss_backend_state *const state = kiss_backend_shared_state();
+    state->posix_to_calendar = backends_posix_to_calendar[posix_to_calendar_backend];
+    state->calendar_to_posix = backends_calendar_to_posix[calendar_to_posix_backend];
+    state->report.posix_to_calendar_backend = posix_to_calendar_backend;
+    state->report.calendar_to_posix_backend = calendar_to_posix_backend;
+    state->report.calibrated = false;
+
+    return true;
+}
+
+KISS_POSIX_TIME_INLINE void backend_report(kiss_backend_report *const report_out){
+    *report_out = kiss_backend_shared_state()->report;
+}
+
+KISS_POSIX_TIME_INLINE kiss_time_t backend_calendar_to_posix(kiss_calendar_time const *const calendar_in){
+    return kiss_backend_shared_state()->calendar_to_posix(calendar_in);
+}
+
+KISS_POSIX_TIME_INLINE void backend_posix_to_calendar(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out){
+    kiss_backend_shared_state()->posix_to_calendar(posix_in, calendar_out);
+}
+
+KISS_POSIX_TIME_INLINE void backend_calendar_to_posix_batch(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out, size_t const n_entries){
+    // look the backend up once for the whole batch
+    kiss_calendar_to_posix_function const function = kiss_backend_shared_state()->calendar_to_posix;
+    for (size_t i=0; i<n_entries; i++){
+        posix_out[i] = function(&calendar_in[i]);
+    }
+}
+
+KISS_POSIX_TIME_INLINE void backend_posix_to_calendar_batch(kiss_time_t const *const posix_in, kiss_calendar_time *const calendar_out, size_t const n_entries){
+    kiss_posix_to_calendar_function const function = kiss_backend_shared_state()->posix_to_calendar;
+    for (size_t i=0; i<n_entries; i++){
+        function(posix_in[i], &calendar_out[i]);
+    }
+}
+
+#endif
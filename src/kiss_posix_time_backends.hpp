@@ -0,0 +1,80 @@
+#ifndef KISS_POSIX_TIME_BACKENDS
+#define KISS_POSIX_TIME_BACKENDS
+
+#include "kiss_posix_time_utils.hpp"
+
+/*
+
+Run time choice of the implementation (backend) of posix_to_calendar and calendar_to_posix.
+
+Which backend is the fastest depends on the CPU (and on the compiler): backend_calibrate times all the backends
+on a small synthetic sample on the current host, and installs the fastest of each into a table of function pointers,
+that the backend_* conversions go through. backend_report tells which backends were chosen, and their timings.
+
+Before any calibration, the table holds the compile time default backends, i.e. the implementations behind
+calendar_to_posix and posix_to_calendar. The table always holds the implementations themselves, without the
+instrumentation of calendar_to_posix and posix_to_calendar: the backend_* conversions are not counted by the
+instrumentation, before or after a calibration.
+
+The table is shared by all threads and is not protected by any lock: call backend_calibrate (or backend_select)
+once at startup, before other threads use the backend_* conversions.
+
+*/
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// data structures
+
+// the available backends, see kiss_posix_time_utils.hpp
+enum kiss_backend : uint8_t
+{
+    KISS_BACKEND_JR = 0,
+    KISS_BACKEND_ORYX,
+    KISS_BACKEND_ERA
+};
+
+static constexpr uint8_t KISS_N_BACKENDS = 3;
+
+// number of conversions timed per backend and per round of calibration
+static constexpr size_t KISS_BACKEND_CALIBRATION_SIZE = 256;
+
+struct kiss_backend_report
+{
+    uint8_t posix_to_calendar_backend;
+    uint8_t calendar_to_posix_backend;
+    bool calibrated;                                       // false if the backends are the defaults, or were chosen by backend_select
+    // best time, in nanoseconds, for KISS_BACKEND_CALIBRATION_SIZE conversions with each backend, from the last
+    // calibration; 0 if not calibrated
+    uint64_t posix_to_calendar_ns[KISS_N_BACKENDS];
+    uint64_t calendar_to_posix_ns[KISS_N_BACKENDS];
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// functions
+
+// name of a backend ("jr", "oryx", "era"), or "unknown"
+char const *backend_name(uint8_t const backend);
+
+// time all backends over n_rounds (at least 1) rounds of KISS_BACKEND_CALIBRATION_SIZE conversions each (the best
+// round counts), and install the fastest ones; a backend that does not give the same results as the default one on
+// the sample is never chosen, and gets a time of UINT64_MAX in the report
+void backend_calibrate(size_t const n_rounds);
+
+// install the given backends, without any timing
+// return true if success, false if one of the backends does not exist (then, nothing is changed)
+bool backend_select(uint8_t const posix_to_calendar_backend, uint8_t const calendar_to_posix_backend);
+
+void backend_report(kiss_backend_report *const report_out);
+
+// the conversions, through the currently installed backends
+kiss_time_t backend_calendar_to_posix(kiss_calendar_time const *const calendar_in);
+void backend_posix_to_calendar(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out);
+void backend_calendar_to_posix_batch(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out, size_t const n_entries);
+void backend_posix_to_calendar_batch(kiss_time_t const *const posix_in, kiss_calendar_time *const calendar_out, size_t const n_entries);
+
+#ifdef KISS_POSIX_TIME_HEADER_ONLY
+  #include "kiss_posix_time_backends.cpp"
+#endif
+
+#endif
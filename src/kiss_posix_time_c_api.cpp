@@ -0,0 +1,280 @@
+#ifndef KISS_POSIX_TIME_C_API_IMPLEMENTATION
+#define KISS_POSIX_TIME_C_API_IMPLEMENTATION
+
+#include "kiss_posix_time_c_api.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// kiss_posix_time_utils
+
+KISS_POSIX_TIME_INLINE bool kiss_is_leap_year(uint16_t const year){
+    return is_leap_year(year);
+}
+
+KISS_POSIX_TIME_INLINE kiss_time_t kiss_calendar_to_posix(kiss_calendar_time const *const calendar_in){
+    return calendar_to_posix(calendar_in);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_posix_to_calendar(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out){
+    posix_to_calendar(posix_in, calendar_out);
+}
+
+KISS_POSIX_TIME_INLINE bool kiss_calendar_is_valid(kiss_calendar_time const *const calendar_in){
+    return calendar_is_valid(calendar_in);
+}
+
+KISS_POSIX_TIME_INLINE uint8_t kiss_calendar_to_posix_checked(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out){
+    return calendar_to_posix_checked(calendar_in, posix_out);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_posix_to_wide_calendar(kiss_time_t const posix_in, kiss_wide_calendar_time *const calendar_out){
+    posix_to_wide_calendar(posix_in, calendar_out);
+}
+
+KISS_POSIX_TIME_INLINE bool kiss_wide_calendar_to_posix(kiss_wide_calendar_time const *const calendar_in, kiss_time_t *const posix_out){
+    return wide_calendar_to_posix(calendar_in, posix_out);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_calendar_to_posix_batch(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out, size_t const n_entries){
+    calendar_to_posix_batch(calendar_in, posix_out, n_entries);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_posix_to_calendar_batch(kiss_time_t const *const posix_in, kiss_calendar_time *const calendar_out, size_t const n_entries){
+    posix_to_calendar_batch(posix_in, calendar_out, n_entries);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_calendar_is_valid_batch(kiss_calendar_time const *const calendar_in, size_t const n_entries, uint8_t *const valid_mask_out){
+    return calendar_is_valid_batch(calendar_in, n_entries, valid_mask_out);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_calendar_to_posix_checked_batch(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out,
+                                                                   size_t const n_entries, uint8_t *const valid_mask_out){
+    return calendar_to_posix_checked_batch(calendar_in, posix_out, n_entries, valid_mask_out);
+}
+
+KISS_POSIX_TIME_INLINE kiss_time_t kiss_posix_to_julian_day_number(kiss_time_t const posix_in){
+    return posix_to_julian_day_number(posix_in);
+}
+
+KISS_POSIX_TIME_INLINE bool kiss_julian_day_number_to_posix(kiss_time_t const julian_day_number_in, kiss_time_t *const posix_out){
+    return julian_day_number_to_posix(julian_day_number_in, posix_out);
+}
+
+KISS_POSIX_TIME_INLINE kiss_time_t kiss_posix_to_modified_julian_day(kiss_time_t const posix_in){
+    return posix_to_modified_julian_day(posix_in);
+}
+
+KISS_POSIX_TIME_INLINE bool kiss_modified_julian_day_to_posix(kiss_time_t const modified_julian_day_in, kiss_time_t *const posix_out){
+    return modified_julian_day_to_posix(modified_julian_day_in, posix_out);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_posix_to_ordinal(kiss_time_t const posix_in, kiss_ordinal_date *const ordinal_out){
+    posix_to_ordinal(posix_in, ordinal_out);
+}
+
+KISS_POSIX_TIME_INLINE bool kiss_ordinal_to_posix(kiss_ordinal_date const *const ordinal_in, kiss_time_t *const posix_out){
+    return ordinal_to_posix(ordinal_in, posix_out);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_posix_to_julian_day_number_batch(kiss_time_t const *const posix_in, kiss_time_t *const julian_day_number_out, size_t const n_entries){
+    posix_to_julian_day_number_batch(posix_in, julian_day_number_out, n_entries);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_posix_to_modified_julian_day_batch(kiss_time_t const *const posix_in, kiss_time_t *const modified_julian_day_out, size_t const n_entries){
+    posix_to_modified_julian_day_batch(posix_in, modified_julian_day_out, n_entries);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_posix_to_ordinal_batch(kiss_time_t const *const posix_in, kiss_ordinal_date *const ordinal_out, size_t const n_entries){
+    posix_to_ordinal_batch(posix_in, ordinal_out, n_entries);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_calendar_step_init(kiss_time_t const n_seconds, kiss_calendar_step *const step_out){
+    calendar_step_init(n_seconds, step_out);
+}
+
+KISS_POSIX_TIME_INLINE bool kiss_calendar_advance(kiss_calendar_time *const calendar_in_out, kiss_calendar_step const *const step){
+    return calendar_advance(calendar_in_out, step);
+}
+
+KISS_POSIX_TIME_INLINE bool kiss_calendar_advance_seconds(kiss_calendar_time *const calendar_in_out, kiss_time_t const n_seconds){
+    return calendar_advance_seconds(calendar_in_out, n_seconds);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_calendar_fill_steps(kiss_calendar_time const *const calendar_start, kiss_time_t const n_seconds,
+                                                       kiss_calendar_time *const calendar_out, size_t const n_entries){
+    return calendar_fill_steps(calendar_start, n_seconds, calendar_out, n_entries);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// kiss_posix_time_extras
+
+KISS_POSIX_TIME_INLINE bool kiss_print_iso_posix(kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size){
+    return print_iso(posix_in, buffer_out, buffer_size);
+}
+
+KISS_POSIX_TIME_INLINE bool kiss_print_iso_calendar(kiss_calendar_time const *const calendar_in, char *const buffer_out, size_t const buffer_size){
+    return print_iso(calendar_in, buffer_out, buffer_size);
+}
+
+KISS_POSIX_TIME_INLINE uint8_t kiss_day_of_week_posix(kiss_time_t const posix_in){
+    return day_of_week(posix_in);
+}
+
+KISS_POSIX_TIME_INLINE uint8_t kiss_day_of_week_calendar(kiss_calendar_time const *const calendar_in){
+    return day_of_week(calendar_in);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_rfc3339_size(kiss_rfc3339_options const *const options){
+    return rfc3339_size(options);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_print_rfc3339(kiss_time_t const posix_in, uint32_t const nanoseconds_in, kiss_rfc3339_options const *const options,
+                                                 char *const buffer_out, size_t const buffer_size){
+    return print_rfc3339(posix_in, nanoseconds_in, options, buffer_out, buffer_size);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_iso_formatter_init(kiss_iso_formatter *const formatter){
+    iso_formatter_init(formatter);
+}
+
+KISS_POSIX_TIME_INLINE char const *kiss_iso_formatter_print(kiss_iso_formatter *const formatter, kiss_time_t const posix_in){
+    return iso_formatter_print(formatter, posix_in);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_text_arena_init(kiss_text_arena *const arena, char *const buffer, size_t const capacity){
+    text_arena_init(arena, buffer, capacity);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_text_arena_clear(kiss_text_arena *const arena){
+    text_arena_clear(arena);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_print_iso_arena_posix(kiss_time_t const *const posix_in, size_t const n_entries, kiss_text_arena *const arena, kiss_text_view *const views_out){
+    return print_iso_arena(posix_in, n_entries, arena, views_out);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_print_iso_arena_calendar(kiss_calendar_time const *const calendar_in, size_t const n_entries, kiss_text_arena *const arena,
+                                                            kiss_text_view *const views_out){
+    return print_iso_arena(calendar_in, n_entries, arena, views_out);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_print_rfc3339_arena(kiss_time_t const *const posix_in, uint32_t const *const nanoseconds_in, size_t const n_entries,
+                                                       kiss_rfc3339_options const *const options, kiss_text_arena *const arena, kiss_text_view *const views_out){
+    return print_rfc3339_arena(posix_in, nanoseconds_in, n_entries, options, arena, views_out);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// kiss_posix_time_decimal
+
+KISS_POSIX_TIME_INLINE bool kiss_parse_epoch_posix(char const *const text_in, size_t const length_in, kiss_time_t *const posix_out){
+    return parse_epoch(text_in, length_in, posix_out);
+}
+
+KISS_POSIX_TIME_INLINE bool kiss_parse_epoch_calendar(char const *const text_in, size_t const length_in, kiss_calendar_time *const calendar_out){
+    return parse_epoch(text_in, length_in, calendar_out);
+}
+
+KISS_POSIX_TIME_INLINE bool kiss_parse_epoch_milliseconds(char const *const text_in, size_t const length_in, kiss_time_t *const posix_out, uint16_t *const milliseconds_out){
+    return parse_epoch_milliseconds(text_in, length_in, posix_out, milliseconds_out);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_parse_epoch_lines_posix(char const *const buffer_in, size_t const buffer_size, kiss_time_t *const posix_out,
+                                                           uint8_t *const valid_mask_out, size_t const max_lines, size_t *const n_bytes_out){
+    return parse_epoch_lines(buffer_in, buffer_size, posix_out, valid_mask_out, max_lines, n_bytes_out);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_parse_epoch_lines_calendar(char const *const buffer_in, size_t const buffer_size, kiss_calendar_time *const calendar_out,
+                                                              uint8_t *const valid_mask_out, size_t const max_lines, size_t *const n_bytes_out){
+    return parse_epoch_lines(buffer_in, buffer_size, calendar_out, valid_mask_out, max_lines, n_bytes_out);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_print_epoch_posix(kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size){
+    return print_epoch(posix_in, buffer_out, buffer_size);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_print_epoch_calendar(kiss_calendar_time const *const calendar_in, char *const buffer_out, size_t const buffer_size){
+    return print_epoch(calendar_in, buffer_out, buffer_size);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_print_epoch_milliseconds(kiss_time_t const posix_in, uint16_t const milliseconds_in, char *const buffer_out, size_t const buffer_size){
+    return print_epoch_milliseconds(posix_in, milliseconds_in, buffer_out, buffer_size);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_print_epoch_arena_posix(kiss_time_t const *const posix_in, size_t const n_entries, kiss_text_arena *const arena, kiss_text_view *const views_out){
+    return print_epoch_arena(posix_in, n_entries, arena, views_out);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_print_epoch_arena_calendar(kiss_calendar_time const *const calendar_in, size_t const n_entries, kiss_text_arena *const arena,
+                                                              kiss_text_view *const views_out){
+    return print_epoch_arena(calendar_in, n_entries, arena, views_out);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// kiss_posix_time_format
+
+KISS_POSIX_TIME_INLINE bool kiss_format_compile(char const *const pattern, kiss_format_program *const program_out){
+    return format_compile(pattern, program_out);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_format_print_posix(kiss_format_program const *const program, kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size){
+    return format_print(program, posix_in, buffer_out, buffer_size);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_format_print_calendar(kiss_format_program const *const program, kiss_calendar_time const *const calendar_in,
+                                                         char *const buffer_out, size_t const buffer_size){
+    return format_print(program, calendar_in, buffer_out, buffer_size);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_format_print_arena_posix(kiss_format_program const *const program, kiss_time_t const *const posix_in, size_t const n_entries,
+                                                            kiss_text_arena *const arena, kiss_text_view *const views_out){
+    return format_print_arena(program, posix_in, n_entries, arena, views_out);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_format_print_arena_calendar(kiss_format_program const *const program, kiss_calendar_time const *const calendar_in, size_t const n_entries,
+                                                               kiss_text_arena *const arena, kiss_text_view *const views_out){
+    return format_print_arena(program, calendar_in, n_entries, arena, views_out);
+}
+
+KISS_POSIX_TIME_INLINE bool kiss_format_parse(kiss_format_program const *const program, char const *const text_in, size_t const length_in,
+                                              kiss_time_t *const posix_out){
+    return format_parse(program, text_in, length_in, posix_out);
+}
+
+KISS_POSIX_TIME_INLINE size_t kiss_format_parse_lines(kiss_format_program const *const program, char const *const buffer_in, size_t const buffer_size,
+                                                      kiss_time_t *const posix_out, uint8_t *const valid_mask_out, size_t const max_lines,
+                                                      size_t *const n_bytes_out){
+    return format_parse_lines(program, buffer_in, buffer_size, posix_out, valid_mask_out, max_lines, n_bytes_out);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// packed calendars, from kiss_posix_time_compression
+
+KISS_POSIX_TIME_INLINE kiss_packed_calendar_t kiss_pack_calendar(kiss_calendar_time const *const calendar_in){
+    return pack_calendar(calendar_in);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_unpack_calendar(kiss_packed_calendar_t const packed_in, kiss_calendar_time *const calendar_out){
+    unpack_calendar(packed_in, calendar_out);
+}
+
+KISS_POSIX_TIME_INLINE kiss_packed_calendar_t kiss_posix_to_packed_calendar(kiss_time_t const posix_in){
+    return posix_to_packed_calendar(posix_in);
+}
+
+KISS_POSIX_TIME_INLINE kiss_time_t kiss_packed_calendar_to_posix(kiss_packed_calendar_t const packed_in){
+    return packed_calendar_to_posix(packed_in);
+}
+
+KISS_POSIX_TIME_INLINE void kiss_packed_calendar_store(kiss_packed_calendar_t const packed_in, uint8_t *const buffer_out){
+    packed_calendar_store(packed_in, buffer_out);
+}
+
+KISS_POSIX_TIME_INLINE kiss_packed_calendar_t kiss_packed_calendar_load(uint8_t const *const buffer_in){
+    return packed_calendar_load(buffer_in);
+}
+
+#endif
@@ -0,0 +1,273 @@
+#ifndef KISS_POSIX_TIME_C_API
+#define KISS_POSIX_TIME_C_API
+
+/*
+
+C API to the conversions of kiss_posix_time_utils, kiss_posix_time_extras, kiss_posix_time_decimal,
+kiss_posix_time_format and the packed calendars of kiss_posix_time_compression, for use from C, or from any language
+with a C FFI (Rust, Python ctypes, etc). All functions have C linkage, names prefixed with kiss_, no overloads, and
+only take plain structs, pointers and integers. Batch versions take a pointer and a number of entries; the bulk
+printers write to a kiss_text_arena.
+
+The other modules are C++ only: kiss_posix_time_fixed_format is compile time templates (kiss_posix_time_format does
+the same at run time), and the codecs, series queries, schedules, cron rules, clock, backends and instrumentation are
+not conversions between time representations, but state and algorithms built on top of them.
+
+The structs are the same as in the C++ API: this header defines them for C, and uses the C++ definitions when
+included from C++, so that calendars can be passed through without any copy.
+
+C++ users can call the C++ API directly: it is the same code, the functions here only forward to it.
+
+*/
+
+#ifdef __cplusplus
+  #include "kiss_posix_time_utils.hpp"
+  #include "kiss_posix_time_extras.hpp"
+  #include "kiss_posix_time_decimal.hpp"
+  #include "kiss_posix_time_format.hpp"
+  #include "kiss_posix_time_compression.hpp"
+#else
+  #include <stdbool.h>
+  #include <stddef.h>
+  #include <stdint.h>
+
+  // see kiss_posix_time_utils.hpp for the conventions used
+  typedef uint64_t kiss_time_t;
+
+  typedef struct kiss_calendar_time
+  {
+      uint16_t year;
+      uint8_t month;
+      uint8_t day;
+      uint8_t hour;
+      uint8_t minute;
+      uint8_t second;
+  } kiss_calendar_time;
+
+  typedef struct kiss_wide_calendar_time
+  {
+      int64_t year;
+      uint8_t month;
+      uint8_t day;
+      uint8_t hour;
+      uint8_t minute;
+      uint8_t second;
+  } kiss_wide_calendar_time;
+
+  typedef struct kiss_ordinal_date
+  {
+      uint16_t year;
+      uint16_t day_of_year;
+  } kiss_ordinal_date;
+
+  typedef struct kiss_calendar_step
+  {
+      kiss_time_t n_seconds;
+      uint32_t days;
+      uint8_t hours;
+      uint8_t minutes;
+      uint8_t seconds;
+  } kiss_calendar_step;
+
+  // see kiss_posix_time_extras.hpp
+  typedef struct kiss_rfc3339_options
+  {
+      uint8_t n_fraction_digits;
+      int16_t offset_minutes;
+  } kiss_rfc3339_options;
+
+  typedef struct kiss_iso_formatter
+  {
+      kiss_time_t posix;
+      kiss_time_t day_start;
+      kiss_calendar_time calendar;
+      char buffer[20];
+      bool valid;
+  } kiss_iso_formatter;
+
+  typedef struct kiss_text_arena
+  {
+      char *buffer;
+      size_t capacity;
+      size_t size;
+  } kiss_text_arena;
+
+  typedef struct kiss_text_view
+  {
+      size_t offset;
+      size_t length;
+  } kiss_text_view;
+
+  // see kiss_posix_time_format.hpp
+  enum
+  {
+      KISS_FORMAT_MAX_OPS = 32,
+      KISS_FORMAT_MAX_LITERALS = 64
+  };
+
+  typedef struct kiss_format_op
+  {
+      uint8_t code;
+      uint8_t literal_offset;
+      uint8_t literal_length;
+  } kiss_format_op;
+
+  typedef struct kiss_format_program
+  {
+      kiss_format_op ops[KISS_FORMAT_MAX_OPS];
+      char literals[KISS_FORMAT_MAX_LITERALS];
+      uint8_t n_ops;
+      uint8_t n_literals;
+      uint16_t max_length;
+      bool needs_posix;
+  } kiss_format_program;
+
+  // see kiss_posix_time_compression.hpp
+  typedef uint64_t kiss_packed_calendar_t;
+
+  enum
+  {
+      KISS_PACKED_CALENDAR_MAX_YEAR = 1970 + 16383,
+      KISS_PACKED_CALENDAR_SIZE = 5
+  };
+
+  // values returned by kiss_calendar_to_posix_checked
+  enum
+  {
+      KISS_CONVERSION_OK = 0,
+      KISS_CONVERSION_INVALID_YEAR,
+      KISS_CONVERSION_INVALID_MONTH,
+      KISS_CONVERSION_INVALID_DAY,
+      KISS_CONVERSION_INVALID_HOUR,
+      KISS_CONVERSION_INVALID_MINUTE,
+      KISS_CONVERSION_INVALID_SECOND
+  };
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// kiss_posix_time_utils
+
+bool kiss_is_leap_year(uint16_t const year);
+
+kiss_time_t kiss_calendar_to_posix(kiss_calendar_time const *const calendar_in);
+void kiss_posix_to_calendar(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out);
+bool kiss_calendar_is_valid(kiss_calendar_time const *const calendar_in);
+
+// return one of the KISS_CONVERSION_* values
+uint8_t kiss_calendar_to_posix_checked(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out);
+
+void kiss_posix_to_wide_calendar(kiss_time_t const posix_in, kiss_wide_calendar_time *const calendar_out);
+bool kiss_wide_calendar_to_posix(kiss_wide_calendar_time const *const calendar_in, kiss_time_t *const posix_out);
+
+void kiss_calendar_to_posix_batch(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out, size_t const n_entries);
+void kiss_posix_to_calendar_batch(kiss_time_t const *const posix_in, kiss_calendar_time *const calendar_out, size_t const n_entries);
+size_t kiss_calendar_is_valid_batch(kiss_calendar_time const *const calendar_in, size_t const n_entries, uint8_t *const valid_mask_out);
+size_t kiss_calendar_to_posix_checked_batch(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out,
+                                            size_t const n_entries, uint8_t *const valid_mask_out);
+
+kiss_time_t kiss_posix_to_julian_day_number(kiss_time_t const posix_in);
+bool kiss_julian_day_number_to_posix(kiss_time_t const julian_day_number_in, kiss_time_t *const posix_out);
+kiss_time_t kiss_posix_to_modified_julian_day(kiss_time_t const posix_in);
+bool kiss_modified_julian_day_to_posix(kiss_time_t const modified_julian_day_in, kiss_time_t *const posix_out);
+void kiss_posix_to_ordinal(kiss_time_t const posix_in, kiss_ordinal_date *const ordinal_out);
+bool kiss_ordinal_to_posix(kiss_ordinal_date const *const ordinal_in, kiss_time_t *const posix_out);
+
+void kiss_posix_to_julian_day_number_batch(kiss_time_t const *const posix_in, kiss_time_t *const julian_day_number_out, size_t const n_entries);
+void kiss_posix_to_modified_julian_day_batch(kiss_time_t const *const posix_in, kiss_time_t *const modified_julian_day_out, size_t const n_entries);
+void kiss_posix_to_ordinal_batch(kiss_time_t const *const posix_in, kiss_ordinal_date *const ordinal_out, size_t const n_entries);
+
+void kiss_calendar_step_init(kiss_time_t const n_seconds, kiss_calendar_step *const step_out);
+bool kiss_calendar_advance(kiss_calendar_time *const calendar_in_out, kiss_calendar_step const *const step);
+bool kiss_calendar_advance_seconds(kiss_calendar_time *const calendar_in_out, kiss_time_t const n_seconds);
+size_t kiss_calendar_fill_steps(kiss_calendar_time const *const calendar_start, kiss_time_t const n_seconds,
+                                kiss_calendar_time *const calendar_out, size_t const n_entries);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// kiss_posix_time_extras
+
+bool kiss_print_iso_posix(kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size);
+bool kiss_print_iso_calendar(kiss_calendar_time const *const calendar_in, char *const buffer_out, size_t const buffer_size);
+
+uint8_t kiss_day_of_week_posix(kiss_time_t const posix_in);
+uint8_t kiss_day_of_week_calendar(kiss_calendar_time const *const calendar_in);
+
+size_t kiss_rfc3339_size(kiss_rfc3339_options const *const options);
+size_t kiss_print_rfc3339(kiss_time_t const posix_in, uint32_t const nanoseconds_in, kiss_rfc3339_options const *const options,
+                          char *const buffer_out, size_t const buffer_size);
+
+void kiss_iso_formatter_init(kiss_iso_formatter *const formatter);
+char const *kiss_iso_formatter_print(kiss_iso_formatter *const formatter, kiss_time_t const posix_in);
+
+void kiss_text_arena_init(kiss_text_arena *const arena, char *const buffer, size_t const capacity);
+void kiss_text_arena_clear(kiss_text_arena *const arena);
+size_t kiss_print_iso_arena_posix(kiss_time_t const *const posix_in, size_t const n_entries, kiss_text_arena *const arena, kiss_text_view *const views_out);
+size_t kiss_print_iso_arena_calendar(kiss_calendar_time const *const calendar_in, size_t const n_entries, kiss_text_arena *const arena,
+                                     kiss_text_view *const views_out);
+size_t kiss_print_rfc3339_arena(kiss_time_t const *const posix_in, uint32_t const *const nanoseconds_in, size_t const n_entries,
+                                kiss_rfc3339_options const *const options, kiss_text_arena *const arena, kiss_text_view *const views_out);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// kiss_posix_time_decimal
+
+bool kiss_parse_epoch_posix(char const *const text_in, size_t const length_in, kiss_time_t *const posix_out);
+bool kiss_parse_epoch_calendar(char const *const text_in, size_t const length_in, kiss_calendar_time *const calendar_out);
+bool kiss_parse_epoch_milliseconds(char const *const text_in, size_t const length_in, kiss_time_t *const posix_out, uint16_t *const milliseconds_out);
+size_t kiss_parse_epoch_lines_posix(char const *const buffer_in, size_t const buffer_size, kiss_time_t *const posix_out,
+                                    uint8_t *const valid_mask_out, size_t const max_lines, size_t *const n_bytes_out);
+size_t kiss_parse_epoch_lines_calendar(char const *const buffer_in, size_t const buffer_size, kiss_calendar_time *const calendar_out,
+                                       uint8_t *const valid_mask_out, size_t const max_lines, size_t *const n_bytes_out);
+
+size_t kiss_print_epoch_posix(kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size);
+size_t kiss_print_epoch_calendar(kiss_calendar_time const *const calendar_in, char *const buffer_out, size_t const buffer_size);
+size_t kiss_print_epoch_milliseconds(kiss_time_t const posix_in, uint16_t const milliseconds_in, char *const buffer_out, size_t const buffer_size);
+size_t kiss_print_epoch_arena_posix(kiss_time_t const *const posix_in, size_t const n_entries, kiss_text_arena *const arena, kiss_text_view *const views_out);
+size_t kiss_print_epoch_arena_calendar(kiss_calendar_time const *const calendar_in, size_t const n_entries, kiss_text_arena *const arena,
+                                       kiss_text_view *const views_out);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// kiss_posix_time_format
+
+bool kiss_format_compile(char const *const pattern, kiss_format_program *const program_out);
+
+size_t kiss_format_print_posix(kiss_format_program const *const program, kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size);
+size_t kiss_format_print_calendar(kiss_format_program const *const program, kiss_calendar_time const *const calendar_in,
+                                  char *const buffer_out, size_t const buffer_size);
+size_t kiss_format_print_arena_posix(kiss_format_program const *const program, kiss_time_t const *const posix_in, size_t const n_entries,
+                                     kiss_text_arena *const arena, kiss_text_view *const views_out);
+size_t kiss_format_print_arena_calendar(kiss_format_program const *const program, kiss_calendar_time const *const calendar_in, size_t const n_entries,
+                                        kiss_text_arena *const arena, kiss_text_view *const views_out);
+
+bool kiss_format_parse(kiss_format_program const *const program, char const *const text_in, size_t const length_in,
+                       kiss_time_t *const posix_out);
+size_t kiss_format_parse_lines(kiss_format_program const *const program, char const *const buffer_in, size_t const buffer_size,
+                               kiss_time_t *const posix_out, uint8_t *const valid_mask_out, size_t const max_lines,
+                               size_t *const n_bytes_out);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// packed calendars, from kiss_posix_time_compression
+
+kiss_packed_calendar_t kiss_pack_calendar(kiss_calendar_time const *const calendar_in);
+void kiss_unpack_calendar(kiss_packed_calendar_t const packed_in, kiss_calendar_time *const calendar_out);
+kiss_packed_calendar_t kiss_posix_to_packed_calendar(kiss_time_t const posix_in);
+kiss_time_t kiss_packed_calendar_to_posix(kiss_packed_calendar_t const packed_in);
+void kiss_packed_calendar_store(kiss_packed_calendar_t const packed_in, uint8_t *const buffer_out);
+kiss_packed_calendar_t kiss_packed_calendar_load(uint8_t const *const buffer_in);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(__cplusplus) && defined(KISS_POSIX_TIME_HEADER_ONLY)
+  #include "kiss_posix_time_c_api.cpp"
+#endif
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef KISS_POSIX_TIME_CLOCK_IMPLEMENTATION
+#define KISS_POSIX_TIME_CLOCK_IMPLEMENTATION
+
+#include "kiss_posix_time_clock.hpp"
+
+#ifndef ARDUINO
+
+#include "kiss_posix_time_extras.hpp"
+#include "kiss_posix_time_instrumentation.hpp"
+#include "kiss_posix_time_shared_state.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// internal helpers
+
+// the iso string, in 64 bits words
+static constexpr size_t CLOCK_ISO_WORDS = 3;
+static_assert(CLOCK_ISO_WORDS * sizeof(uint64_t) >= sizeof(kiss_clock_snapshot::iso), "the iso string must fit in the cache");
+
+// cached posix value of an empty cache; this is never a second of the source
+static constexpr uint64_t CLOCK_EMPTY = UINT64_MAX;
+
+// reads of the cache that can fail because of a concurrent update, before decoding without the cache
+static constexpr size_t CLOCK_READ_ATTEMPTS = 4;
+
+struct kiss_clock_state
+{
+    std::atomic<kiss_clock_source> source;
+    std::atomic<uint64_t> sequence;     // odd while the cache is being updated
+    std::atomic<uint64_t> posix;
+    std::atomic<uint64_t> calendar;     // packed, see clock_pack_calendar
+    std::atomic<uint64_t> iso[CLOCK_ISO_WORDS];
+};
+
+// the function local static is in an external function, so that there is a single clock also in header-only mode
+KISS_POSIX_TIME_INLINE kiss_clock_state *kiss_clock_shared_state(){
+    static kiss_clock_state state {{clock_system_source}, {0}, {CLOCK_EMPTY}, {0}, {{0}, {0}, {0}}};
+    return &state;
+}
+
+static uint64_t clock_pack_calendar(kiss_calendar_time const *const calendar_in){
+    return (static_cast<uint64_t>(calendar_in->year) << 40) | (static_cast<uint64_t>(calendar_in->month) << 32)
+           | (static_cast<uint64_t>(calendar_in->day) << 24) | (static_cast<uint64_t>(calendar_in->hour) << 16)
+           | (static_cast<uint64_t>(calendar_in->minute) << 8) | static_cast<uint64_t>(calendar_in->second);
+}
+
+static void clock_unpack_calendar(uint64_t const packed, kiss_calendar_time *const calendar_out){
+    calendar_out->year = static_cast<uint16_t>(packed >> 40);
+    calendar_out->month = static_cast<uint8_t>(packed >> 32);
+    calendar_out->day = static_cast<uint8_t>(packed >> 24);
+    calendar_out->hour = static_cast<uint8_t>(packed >> 16);
+    calendar_out->minute = static_cast<uint8_t>(packed >> 8);
+    calendar_out->second = static_cast<uint8_t>(packed);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// functions
+
+KISS_POSIX_TIME_INLINE kiss_time_t clock_system_source(){
+    int64_t const seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return (seconds > 0) ? static_cast<kiss_time_t>(seconds) : 0;
+}
+
+KISS_POSIX_TIME_INLINE void clock_set_source(kiss_clock_source const source){
+    kiss_clock_state *const state = kiss_clock_shared_state();
+    state->source.store(source, std::memory_order_relaxed);
+    state->posix.store(CLOCK_EMPTY, std::memory_order_relaxed);
+    // a new sequence number, so that a reader that raced with this does not use the old cache
+    state->sequence.fetch_add(2, std::memory_order_release);
+}
+
+KISS_POSIX_TIME_INLINE void clock_now(kiss_clock_snapshot *const snapshot_out){
+    kiss_clock_state *const state = kiss_clock_shared_state();
+    kiss_time_t const now = state->source.load(std::memory_order_relaxed)();
+
+    // read the cache; an even sequence number seen during the reads, if any, is where an update can start from
+    bool have_even_sequence {false};
+    uint64_t even_sequence {0};
+    // the latest second seen in the cache, also from reads that raced with an update: it was returned to some caller,
+    // so that the clock must not go back before it, even if no read succeeds
+    uint64_t latest {now};
+
+    for (size_t attempt=0; attempt<CLOCK_READ_ATTEMPTS; attempt++){
+        uint64_t const sequence_before = state->sequence.load(std::memory_order_acquire);
+        uint64_t const posix = state->posix.load(std::memory_order_relaxed);
+        if (posix != CLOCK_EMPTY && posix > latest){
+            latest = posix;
+        }
+        if (sequence_before % 2 == 1){
+            continue;
+        }
+
+        uint64_t const calendar = state->calendar.load(std::memory_order_relaxed);
+        uint64_t iso[CLOCK_ISO_WORDS];
+        for (size_t i=0; i<CLOCK_ISO_WORDS; i++){
+            iso[i] = state->iso[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (state->sequence.load(std::memory_order_relaxed) != sequence_before){
+            continue;
+        }
+
+        have_even_sequence = true;
+        even_sequence = sequence_before;
+
+        // the same second, or a second before the cached one: the clock does not go back
+        if (posix != CLOCK_EMPTY && posix >= now){
+            KISS_INSTRUMENT_COUNT(KISS_COUNT_CLOCK_HITS, 1);
+            snapshot_out->posix = posix;
+            clock_unpack_calendar(calendar, &snapshot_out->calendar);
+            memcpy(snapshot_out->iso, iso, sizeof(snapshot_out->iso));
+            return;
+        }
+
+        break;
+    }
+
+    // new second (or too much contention): decode without the cache
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_CLOCK_MISSES, 1);
+    snapshot_out->posix = latest;
+    posix_to_calendar(latest, &snapshot_out->calendar);
+    print_iso(&snapshot_out->calendar, snapshot_out->iso, sizeof(snapshot_out->iso));
+
+    // and publish it, unless another thread is already updating the cache
+    if (!have_even_sequence){
+        return;
+    }
+    if (!state->sequence.compare_exchange_strong(even_sequence, even_sequence + 1, std::memory_order_relaxed)){
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // another thread may have published a later second since this one read the cache
+    uint64_t const cached_posix = state->posix.load(std::memory_order_relaxed);
+    if (cached_posix == CLOCK_EMPTY || cached_posix < latest){
+        uint64_t iso[CLOCK_ISO_WORDS] {};
+        memcpy(iso, snapshot_out->iso, sizeof(snapshot_out->iso));
+
+        state->posix.store(latest, std::memory_order_relaxed);
+        state->calendar.store(clock_pack_calendar(&snapshot_out->calendar), std::memory_order_relaxed);
+        for (size_t i=0; i<CLOCK_ISO_WORDS; i++){
+            state->iso[i].store(iso[i], std::memory_order_relaxed);
+        }
+    }
+
+    state->sequence.store(even_sequence + 2, std::memory_order_release);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef KISS_POSIX_TIME_CLOCK
+#define KISS_POSIX_TIME_CLOCK
+
+#include "kiss_posix_time_utils.hpp"
+
+/*
+
+A shared "now" clock, for code that needs the current time as a calendar and as an ISO string many times per second
+(for example, to timestamp requests or log lines).
+
+clock_now reads the clock source, and if the second did not change since the last update, copies the calendar and
+the ISO string that were cached for this second, instead of running posix_to_calendar and print_iso again. The first
+caller that sees a new second decodes it and updates the cache (lazy update on second rollover, no background thread).
+
+The cache is a seqlock: a sequence number, that is odd while the cache is being updated, and the cached data, all held
+in atomic words. Readers never take a lock: they retry if they raced with an update, and after a few failed attempts
+decode the time themselves. A single thread at a time updates the cache (the one that wins a compare-and-swap on the
+sequence number); the others decode their own copy meanwhile.
+
+The clock does not go back: if the source returns a second before the cached one (for example, the system clock was
+set back), clock_now keeps returning the cached second until the source catches up. This also holds for the readers
+that decode the time themselves: they decode the latest of the source and of the cached seconds they saw.
+
+This needs C++11 atomics, so this is not available on Arduino (the module is empty there).
+
+*/
+
+#ifndef ARDUINO
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// data structures
+
+struct kiss_clock_snapshot
+{
+    kiss_time_t posix;
+    kiss_calendar_time calendar;
+    char iso[20];     // "YYYY-MM-DDTHH:MM:SS", null terminated
+};
+
+// the source of the current posix time, in seconds
+using kiss_clock_source = kiss_time_t (*)();
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// functions
+
+// the default clock source: std::chrono::system_clock, truncated to the second (0 before 1970)
+kiss_time_t clock_system_source();
+
+// use another clock source (for example a fake clock in tests, or a coarse clock of the OS), and empty the cache
+// this must not be called while other threads use clock_now
+void clock_set_source(kiss_clock_source const source);
+
+// the current time, thread safe and lock-free
+void clock_now(kiss_clock_snapshot *const snapshot_out);
+
+#ifdef KISS_POSIX_TIME_HEADER_ONLY
+  #include "kiss_posix_time_clock.cpp"
+#endif
+
+#endif
+
+#endif
@@ -0,0 +1,628 @@
+#ifndef KISS_POSIX_TIME_COMPRESSION_IMPLEMENTATION
+#define KISS_POSIX_TIME_COMPRESSION_IMPLEMENTATION
+
+#include "kiss_posix_time_compression.hpp"
+
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// internal helpers
+
+// index of the lowest set bit, mask must not be 0
+static uint8_t compression_lowest_bit(uint64_t const mask){
+    #if defined(__GNUC__)
+        return static_cast<uint8_t>(__builtin_ctzll(mask));
+    #else
+        uint8_t index {0};
+        while (((mask >> index) & 1) == 0){
+            index++;
+        }
+        return index;
+    #endif
+}
+
+static void compression_write_u32(uint8_t *const buffer, uint32_t const value){
+    for (size_t i=0; i<4; i++){
+        buffer[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+static uint32_t compression_read_u32(uint8_t const *const buffer){
+    uint32_t value {0};
+    for (size_t i=0; i<4; i++){
+        value |= static_cast<uint32_t>(buffer[i]) << (8 * i);
+    }
+    return value;
+}
+
+// the next 64 bits of the stream starting at bit_position, bits past the end of the buffer read as 0;
+// only the lowest 64 - bit_position % 8 bits (i.e. at least 57) are meaningful
+static uint64_t compression_peek_bits(uint8_t const *const buffer, size_t const size, size_t const bit_position){
+    size_t const first_byte = bit_position / 8;
+    uint64_t window {0};
+
+    if (first_byte + 8 <= size){
+        // the usual case: a fixed length loop, that the compiler turns into a single load on little endian targets
+        for (size_t i=0; i<8; i++){
+            window |= static_cast<uint64_t>(buffer[first_byte + i]) << (8 * i);
+        }
+    }
+    else{
+        for (size_t i=0; first_byte + i < size; i++){
+            window |= static_cast<uint64_t>(buffer[first_byte + i]) << (8 * i);
+        }
+    }
+
+    return window >> (bit_position % 8);
+}
+
+// read n_bits (at most 64) bits of the stream starting at bit_position
+static uint64_t compression_read_bits(uint8_t const *const buffer, size_t const size, size_t const bit_position, uint8_t const n_bits){
+    if (n_bits == 0){
+        return 0;
+    }
+    if (n_bits <= 32){
+        return compression_peek_bits(buffer, size, bit_position) & ((static_cast<uint64_t>(1) << n_bits) - 1);
+    }
+    return (compression_peek_bits(buffer, size, bit_position) & 0xFFFFFFFF)
+           | (compression_read_bits(buffer, size, bit_position + 32, static_cast<uint8_t>(n_bits - 32)) << 32);
+}
+
+// write the n_bits (at most 64) lowest bits of value; the buffer must be large enough
+static void compression_write_bits(uint8_t *const buffer, size_t *const bit_position, uint64_t value, uint8_t n_bits){
+    while (n_bits > 0){
+        size_t const byte = *bit_position / 8;
+        uint8_t const offset = static_cast<uint8_t>(*bit_position % 8);
+        if (offset == 0){
+            buffer[byte] = 0;
+        }
+
+        uint8_t const n_bits_in_byte = (n_bits < 8 - offset) ? n_bits : static_cast<uint8_t>(8 - offset);
+        buffer[byte] = static_cast<uint8_t>(buffer[byte] | ((value & ((1u << n_bits_in_byte) - 1)) << offset));
+
+        value >>= n_bits_in_byte;
+        n_bits = static_cast<uint8_t>(n_bits - n_bits_in_byte);
+        *bit_position += n_bits_in_byte;
+    }
+}
+
+// map signed differences (stored in 2-complement in a uint64_t) to unsigned: 0, -1, 1, -2, 2, ... -> 0, 1, 2, 3, 4, ...
+static uint64_t compression_zigzag(uint64_t const value){
+    return (value << 1) ^ (0 - (value >> 63));
+}
+
+static uint64_t compression_unzigzag(uint64_t const value){
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+// decode n_values values from a single dod stream
+static bool dod_decode_bits(uint8_t const *const buffer, size_t const size, size_t const n_values, kiss_time_t *const values_out){
+    size_t const size_bits = size * 8;
+    size_t bit_position {0};
+
+    if (n_values == 0){
+        return true;
+    }
+    if (size_bits < 64){
+        return false;
+    }
+
+    kiss_time_t value = compression_read_bits(buffer, size, 0, 64);
+    kiss_time_t delta {0};
+    bit_position = 64;
+    values_out[0] = value;
+
+    // payload length for each possible number of leading 1 bits in the prefix
+    uint8_t const payload_bits[6] {0, 7, 9, 12, 32, 64};
+
+    size_t i {1};
+    while (i < n_values){
+        if (bit_position >= size_bits){
+            return false;
+        }
+
+        uint64_t const window = compression_peek_bits(buffer, size, bit_position);
+
+        if ((window & 1) == 0){
+            // a run of values with the same delta: take all of them at once
+            size_t run = 64 - bit_position % 8;
+            if (window != 0 && compression_lowest_bit(window) < run){
+                run = compression_lowest_bit(window);
+            }
+            if (run > n_values - i){
+                run = n_values - i;
+            }
+            if (run > size_bits - bit_position){
+                run = size_bits - bit_position;
+            }
+
+            for (size_t j=0; j<run; j++){
+                value += delta;
+                values_out[i + j] = value;
+            }
+            i += run;
+            bit_position += run;
+            continue;
+        }
+
+        uint8_t n_ones = compression_lowest_bit(~window);
+        if (n_ones > 5){
+            n_ones = 5;
+        }
+        bit_position += (n_ones < 5) ? n_ones + 1u : 5u;
+
+        uint8_t const n_payload_bits = payload_bits[n_ones];
+        if (bit_position + n_payload_bits > size_bits){
+            return false;
+        }
+
+        uint64_t const zigzag_dod = compression_read_bits(buffer, size, bit_position, n_payload_bits);
+        bit_position += n_payload_bits;
+
+        delta += compression_unzigzag(zigzag_dod);
+        value += delta;
+        values_out[i] = value;
+        i++;
+    }
+
+    return true;
+}
+
+// number of bits needed to represent value
+static uint8_t compression_bit_width(uint64_t const value){
+    uint8_t width {0};
+    while (width < 64 && (value >> width) != 0){
+        width++;
+    }
+    return width;
+}
+
+// size in bytes of a for block of n_values values packed on bit_width bits
+static size_t for_block_size(size_t const n_values, uint8_t const bit_width){
+    return 9 + (n_values * bit_width + 7) / 8;
+}
+
+// the 8 bytes starting at buffer as a little endian word; the compilers do not always merge the byte loop into a
+// single load when it is inlined in a loop, so use memcpy on the targets where this is the native order
+static uint64_t compression_load_u64(uint8_t const *const buffer){
+    uint64_t word {0};
+    #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        memcpy(&word, buffer, 8);
+    #else
+        for (size_t i=0; i<8; i++){
+            word |= static_cast<uint64_t>(buffer[i]) << (8 * i);
+        }
+    #endif
+    return word;
+}
+
+// unpack n_values offsets packed on bit_width bits, and add the reference
+// value i is in the 64 bits word that starts at byte i * bit_width / 8, shifted by i * bit_width % 8: one load, one
+// shift and one mask per value, with no branch and no dependency between the values, so that the compiler can unroll
+// and vectorize the loop; this needs values of at most 56 bits, and the 8 bytes of the word in the buffer, so the very
+// wide values and the last few ones of the buffer are read bit by bit
+static void for_unpack(uint8_t const *const packed, size_t const packed_size, uint8_t const bit_width,
+                       kiss_time_t const reference, size_t const n_values, kiss_time_t *const values_out){
+    if (bit_width == 0){
+        for (size_t i=0; i<n_values; i++){
+            values_out[i] = reference;
+        }
+        return;
+    }
+
+    size_t n_words {0};
+    if (bit_width <= 56 && packed_size >= 8){
+        size_t const last_word_value = ((packed_size - 8) * 8 + 7) / bit_width;
+        n_words = (last_word_value < n_values) ? last_word_value + 1 : n_values;
+    }
+
+    uint64_t const mask = (bit_width < 64) ? (static_cast<uint64_t>(1) << bit_width) - 1 : ~static_cast<uint64_t>(0);
+    for (size_t i=0; i<n_words; i++){
+        size_t const bit_position = i * bit_width;
+        values_out[i] = reference + ((compression_load_u64(&packed[bit_position / 8]) >> (bit_position % 8)) & mask);
+    }
+
+    for (size_t i=n_words; i<n_values; i++){
+        values_out[i] = reference + compression_read_bits(packed, packed_size, i * bit_width, bit_width);
+    }
+}
+
+// number of values in the for block that starts with value block_start, out of n_values
+static size_t for_n_values_in_block(size_t const n_values, size_t const block_start){
+    return (n_values - block_start < KISS_FOR_BLOCK_LENGTH) ? n_values - block_start : KISS_FOR_BLOCK_LENGTH;
+}
+
+// check the header of the for block at position, with n_values_in_block values, and give its size in bytes
+// return false if the buffer is not valid
+static bool for_check_block(uint8_t const *const buffer, size_t const size, size_t const position, size_t const n_values_in_block,
+                            size_t *const block_size_out){
+    if (position + 9 > size || buffer[position + 8] > 64){
+        return false;
+    }
+    size_t const block_size = for_block_size(n_values_in_block, buffer[position + 8]);
+    if (position + block_size > size){
+        return false;
+    }
+    *block_size_out = block_size;
+    return true;
+}
+
+// decode the for block at position, checked by for_check_block
+static void for_decode_checked_block(uint8_t const *const buffer, size_t const size, size_t const position, size_t const n_values_in_block,
+                                     kiss_time_t *const values_out){
+    kiss_time_t const reference = compression_read_bits(&buffer[position], size - position, 0, 64);
+    for_unpack(&buffer[position + 9], size - position - 9, buffer[position + 8], reference, n_values_in_block, values_out);
+}
+
+// find where a for block starts, walking the block headers; return false if the buffer is not valid
+static bool for_find_block(uint8_t const *const buffer, size_t const size, size_t const block_index,
+                           size_t *const block_start_out, size_t *const n_values_in_block_out){
+    size_t const n_values = for_n_values(buffer, size);
+    size_t position {4};
+
+    for (size_t block=0; block*KISS_FOR_BLOCK_LENGTH<n_values; block++){
+        size_t const n_values_in_block = for_n_values_in_block(n_values, block * KISS_FOR_BLOCK_LENGTH);
+        size_t block_size {0};
+        if (!for_check_block(buffer, size, position, n_values_in_block, &block_size)){
+            return false;
+        }
+
+        if (block == block_index){
+            *block_start_out = position;
+            *n_values_in_block_out = n_values_in_block;
+            return true;
+        }
+        position += block_size;
+    }
+
+    return false;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// delta-of-delta functions
+
+KISS_POSIX_TIME_INLINE void dod_encoder_init(kiss_dod_encoder *const encoder, uint8_t *const buffer, size_t const capacity){
+    encoder->buffer = buffer;
+    encoder->capacity = capacity;
+    encoder->n_bits = 0;
+    encoder->n_values = 0;
+    encoder->previous = 0;
+    encoder->previous_delta = 0;
+    encoder->overflow = false;
+}
+
+KISS_POSIX_TIME_INLINE bool dod_encoder_push(kiss_dod_encoder *const encoder, kiss_time_t const value){
+    if (encoder->overflow){
+        return false;
+    }
+
+    // find out what we need to write: prefix (stored least significant bit first) and payload
+    uint64_t prefix {0};
+    uint8_t n_prefix_bits {0};
+    uint64_t payload {value};
+    uint8_t n_payload_bits {64};
+    kiss_time_t const delta = value - encoder->previous;
+
+    if (encoder->n_values > 0){
+        payload = compression_zigzag(delta - encoder->previous_delta);
+
+        if (payload == 0){
+            n_prefix_bits = 1;
+            n_payload_bits = 0;
+        }
+        else if (payload < (1u << 7)){
+            prefix = 0x1;
+            n_prefix_bits = 2;
+            n_payload_bits = 7;
+        }
+        else if (payload < (1u << 9)){
+            prefix = 0x3;
+            n_prefix_bits = 3;
+            n_payload_bits = 9;
+        }
+        else if (payload < (1u << 12)){
+            prefix = 0x7;
+            n_prefix_bits = 4;
+            n_payload_bits = 12;
+        }
+        else if (payload < (static_cast<uint64_t>(1) << 32)){
+            prefix = 0xF;
+            n_prefix_bits = 5;
+            n_payload_bits = 32;
+        }
+        else{
+            prefix = 0x1F;
+            n_prefix_bits = 5;
+            n_payload_bits = 64;
+        }
+    }
+
+    // never write half a value
+    if ((encoder->n_bits + n_prefix_bits + n_payload_bits + 7) / 8 > encoder->capacity){
+        encoder->overflow = true;
+        return false;
+    }
+
+    compression_write_bits(encoder->buffer, &encoder->n_bits, prefix, n_prefix_bits);
+    compression_write_bits(encoder->buffer, &encoder->n_bits, payload, n_payload_bits);
+
+    if (encoder->n_values > 0){
+        encoder->previous_delta = delta;
+    }
+    encoder->previous = value;
+    encoder->n_values++;
+
+    return true;
+}
+
+KISS_POSIX_TIME_INLINE size_t dod_encoder_size(kiss_dod_encoder const *const encoder){
+    return (encoder->n_bits + 7) / 8;
+}
+
+KISS_POSIX_TIME_INLINE bool dod_decode_stream(uint8_t const *const buffer, size_t const size, size_t const n_values, kiss_time_t *const values_out){
+    return dod_decode_bits(buffer, size, n_values, values_out);
+}
+
+KISS_POSIX_TIME_INLINE size_t dod_encode(kiss_time_t const *const values, size_t const n_values, size_t const block_length,
+                                         uint8_t *const buffer, size_t const capacity){
+    if (block_length == 0 || block_length > 0xFFFFFFFF || n_values > 0xFFFFFFFF){
+        return 0;
+    }
+
+    size_t const n_blocks = (n_values + block_length - 1) / block_length;
+    size_t const header_size = 8 + 4 * n_blocks;
+    if (capacity < header_size){
+        return 0;
+    }
+
+    compression_write_u32(&buffer[0], static_cast<uint32_t>(n_values));
+    compression_write_u32(&buffer[4], static_cast<uint32_t>(block_length));
+
+    size_t offset {0};
+    for (size_t block=0; block<n_blocks; block++){
+        if (offset > 0xFFFFFFFF){
+            return 0;
+        }
+        compression_write_u32(&buffer[8 + 4 * block], static_cast<uint32_t>(offset));
+
+        kiss_dod_encoder encoder;
+        dod_encoder_init(&encoder, &buffer[header_size + offset], capacity - header_size - offset);
+        for (size_t i=block*block_length; i<n_values && i<(block+1)*block_length; i++){
+            if (!dod_encoder_push(&encoder, values[i])){
+                return 0;
+            }
+        }
+        offset += dod_encoder_size(&encoder);
+    }
+
+    return header_size + offset;
+}
+
+KISS_POSIX_TIME_INLINE size_t dod_n_values(uint8_t const *const buffer, size_t const size){
+    if (size < 8){
+        return 0;
+    }
+    return compression_read_u32(&buffer[0]);
+}
+
+KISS_POSIX_TIME_INLINE size_t dod_n_blocks(uint8_t const *const buffer, size_t const size){
+    if (size < 8){
+        return 0;
+    }
+    size_t const n_values = compression_read_u32(&buffer[0]);
+    size_t const block_length = compression_read_u32(&buffer[4]);
+    if (block_length == 0){
+        return 0;
+    }
+    return (n_values + block_length - 1) / block_length;
+}
+
+KISS_POSIX_TIME_INLINE size_t dod_decode_block(uint8_t const *const buffer, size_t const size, size_t const block_index, kiss_time_t *const values_out){
+    size_t const n_blocks = dod_n_blocks(buffer, size);
+    size_t const header_size = 8 + 4 * n_blocks;
+    if (block_index >= n_blocks || size < header_size){
+        return 0;
+    }
+
+    size_t const n_values = compression_read_u32(&buffer[0]);
+    size_t const block_length = compression_read_u32(&buffer[4]);
+    size_t const start = header_size + compression_read_u32(&buffer[8 + 4 * block_index]);
+    size_t const end = (block_index + 1 < n_blocks) ? header_size + compression_read_u32(&buffer[8 + 4 * (block_index + 1)]) : size;
+    if (start > end || end > size){
+        return 0;
+    }
+
+    size_t n_values_in_block = n_values - block_index * block_length;
+    if (n_values_in_block > block_length){
+        n_values_in_block = block_length;
+    }
+
+    if (!dod_decode_bits(&buffer[start], end - start, n_values_in_block, values_out)){
+        return 0;
+    }
+    return n_values_in_block;
+}
+
+KISS_POSIX_TIME_INLINE size_t dod_decode(uint8_t const *const buffer, size_t const size, kiss_time_t *const values_out, size_t const max_values){
+    size_t const n_values = dod_n_values(buffer, size);
+    size_t const n_blocks = dod_n_blocks(buffer, size);
+    if (n_values > max_values){
+        return 0;
+    }
+
+    size_t n_decoded {0};
+    for (size_t block=0; block<n_blocks; block++){
+        size_t const n_decoded_in_block = dod_decode_block(buffer, size, block, &values_out[n_decoded]);
+        if (n_decoded_in_block == 0){
+            return 0;
+        }
+        n_decoded += n_decoded_in_block;
+    }
+
+    return n_decoded;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// frame-of-reference functions
+
+KISS_POSIX_TIME_INLINE size_t for_max_encoded_size(size_t const n_values){
+    size_t const n_blocks = (n_values + KISS_FOR_BLOCK_LENGTH - 1) / KISS_FOR_BLOCK_LENGTH;
+    return 4 + 9 * n_blocks + 8 * n_values;
+}
+
+KISS_POSIX_TIME_INLINE size_t for_encode(kiss_time_t const *const values, size_t const n_values, uint8_t *const buffer, size_t const capacity){
+    if (capacity < 4 || n_values > 0xFFFFFFFF){
+        return 0;
+    }
+    compression_write_u32(&buffer[0], static_cast<uint32_t>(n_values));
+    size_t position {4};
+
+    for (size_t block_start=0; block_start<n_values; block_start+=KISS_FOR_BLOCK_LENGTH){
+        size_t n_values_in_block = n_values - block_start;
+        if (n_values_in_block > KISS_FOR_BLOCK_LENGTH){
+            n_values_in_block = KISS_FOR_BLOCK_LENGTH;
+        }
+
+        kiss_time_t minimum {values[block_start]};
+        kiss_time_t maximum {values[block_start]};
+        for (size_t i=block_start; i<block_start+n_values_in_block; i++){
+            minimum = (values[i] < minimum) ? values[i] : minimum;
+            maximum = (values[i] > maximum) ? values[i] : maximum;
+        }
+        uint8_t const bit_width = compression_bit_width(maximum - minimum);
+
+        if (position + for_block_size(n_values_in_block, bit_width) > capacity){
+            return 0;
+        }
+
+        size_t bit_position {0};
+        compression_write_bits(&buffer[position], &bit_position, minimum, 64);
+        compression_write_bits(&buffer[position], &bit_position, bit_width, 8);
+        for (size_t i=block_start; i<block_start+n_values_in_block; i++){
+            compression_write_bits(&buffer[position], &bit_position, values[i] - minimum, bit_width);
+        }
+
+        position += for_block_size(n_values_in_block, bit_width);
+    }
+
+    return position;
+}
+
+KISS_POSIX_TIME_INLINE size_t for_n_values(uint8_t const *const buffer, size_t const size){
+    if (size < 4){
+        return 0;
+    }
+    return compression_read_u32(&buffer[0]);
+}
+
+KISS_POSIX_TIME_INLINE size_t for_n_blocks(uint8_t const *const buffer, size_t const size){
+    return (for_n_values(buffer, size) + KISS_FOR_BLOCK_LENGTH - 1) / KISS_FOR_BLOCK_LENGTH;
+}
+
+KISS_POSIX_TIME_INLINE size_t for_decode_block(uint8_t const *const buffer, size_t const size, size_t const block_index, kiss_time_t *const values_out){
+    size_t block_start;
+    size_t n_values_in_block;
+    if (!for_find_block(buffer, size, block_index, &block_start, &n_values_in_block)){
+        return 0;
+    }
+
+    for_decode_checked_block(buffer, size, block_start, n_values_in_block, values_out);
+    return n_values_in_block;
+}
+
+KISS_POSIX_TIME_INLINE size_t for_decode(uint8_t const *const buffer, size_t const size, kiss_time_t *const values_out, size_t const max_values){
+    size_t const n_values = for_n_values(buffer, size);
+    if (n_values > max_values){
+        return 0;
+    }
+
+    // walk the blocks once, rather than looking for each block from the start
+    size_t position {4};
+    for (size_t block_start=0; block_start<n_values; block_start+=KISS_FOR_BLOCK_LENGTH){
+        size_t const n_values_in_block = for_n_values_in_block(n_values, block_start);
+        size_t block_size {0};
+        if (!for_check_block(buffer, size, position, n_values_in_block, &block_size)){
+            return 0;
+        }
+        for_decode_checked_block(buffer, size, position, n_values_in_block, &values_out[block_start]);
+        position += block_size;
+    }
+
+    return n_values;
+}
+
+KISS_POSIX_TIME_INLINE size_t for_decode_to_calendar(uint8_t const *const buffer, size_t const size, kiss_calendar_time *const calendars_out, size_t const max_values){
+    size_t const n_values = for_n_values(buffer, size);
+    if (n_values > max_values){
+        return 0;
+    }
+
+    // as for_decode, walk the blocks once, with each block going through the stack before its conversion
+    kiss_time_t working_values[KISS_FOR_BLOCK_LENGTH];
+    size_t position {4};
+    for (size_t block_start=0; block_start<n_values; block_start+=KISS_FOR_BLOCK_LENGTH){
+        size_t const n_values_in_block = for_n_values_in_block(n_values, block_start);
+        size_t block_size {0};
+        if (!for_check_block(buffer, size, position, n_values_in_block, &block_size)){
+            return 0;
+        }
+        for_decode_checked_block(buffer, size, position, n_values_in_block, working_values);
+        posix_to_calendar_batch(working_values, &calendars_out[block_start], n_values_in_block);
+        position += block_size;
+    }
+
+    return n_values;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// packed calendar functions
+
+KISS_POSIX_TIME_INLINE kiss_packed_calendar_t pack_calendar(kiss_calendar_time const *const calendar_in){
+    return (static_cast<kiss_packed_calendar_t>(calendar_in->year - EPOCH_START) << 26)
+           | (static_cast<kiss_packed_calendar_t>(calendar_in->month) << 22)
+           | (static_cast<kiss_packed_calendar_t>(calendar_in->day) << 17)
+           | (static_cast<kiss_packed_calendar_t>(calendar_in->hour) << 12)
+           | (static_cast<kiss_packed_calendar_t>(calendar_in->minute) << 6)
+           | static_cast<kiss_packed_calendar_t>(calendar_in->second);
+}
+
+KISS_POSIX_TIME_INLINE void unpack_calendar(kiss_packed_calendar_t const packed_in, kiss_calendar_time *const calendar_out){
+    calendar_out->year = static_cast<uint16_t>(((packed_in >> 26) & 0x3FFF) + EPOCH_START);
+    calendar_out->month = static_cast<uint8_t>((packed_in >> 22) & 0xF);
+    calendar_out->day = static_cast<uint8_t>((packed_in >> 17) & 0x1F);
+    calendar_out->hour = static_cast<uint8_t>((packed_in >> 12) & 0x1F);
+    calendar_out->minute = static_cast<uint8_t>((packed_in >> 6) & 0x3F);
+    calendar_out->second = static_cast<uint8_t>(packed_in & 0x3F);
+}
+
+KISS_POSIX_TIME_INLINE kiss_packed_calendar_t posix_to_packed_calendar(kiss_time_t const posix_in){
+    kiss_calendar_time working_calendar;
+    posix_to_calendar(posix_in, &working_calendar);
+    return pack_calendar(&working_calendar);
+}
+
+KISS_POSIX_TIME_INLINE kiss_time_t packed_calendar_to_posix(kiss_packed_calendar_t const packed_in){
+    kiss_calendar_time working_calendar;
+    unpack_calendar(packed_in, &working_calendar);
+    return calendar_to_posix(&working_calendar);
+}
+
+KISS_POSIX_TIME_INLINE void packed_calendar_store(kiss_packed_calendar_t const packed_in, uint8_t *const buffer_out){
+    for (size_t i=0; i<KISS_PACKED_CALENDAR_SIZE; i++){
+        buffer_out[i] = static_cast<uint8_t>(packed_in >> (8 * (KISS_PACKED_CALENDAR_SIZE - 1 - i)));
+    }
+}
+
+KISS_POSIX_TIME_INLINE kiss_packed_calendar_t packed_calendar_load(uint8_t const *const buffer_in){
+    kiss_packed_calendar_t packed {0};
+    for (size_t i=0; i<KISS_PACKED_CALENDAR_SIZE; i++){
+        packed = (packed << 8) | buffer_in[i];
+    }
+    return packed;
+}
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef KISS_POSIX_TIME_COMPRESSION
+#define KISS_POSIX_TIME_COMPRESSION
+
+#include "kiss_posix_time_utils.hpp"
+
+/*
+
+Compact encodings of series of posix times, for storage and transmission.
+
+- delta-of-delta (dod) encoding, similar to the Facebook Gorilla timestamp encoding: well suited for sorted
+series with a mostly regular cadence; a series with a perfectly regular cadence takes 1 bit per timestamp.
+- frame-of-reference (for) encoding: well suited for unsorted series spanning a limited range of time; each
+block of values stores its minimum, and the offsets of all values to this minimum on as few bits as possible.
+- packed calendar: a kiss_calendar_time packed in 40 bits, that can be compared and sorted as an integer.
+
+All the functions write to / read from caller owned byte buffers, there is no dynamic allocation. The encoded data
+does not depend on the platform, so that it can be exchanged between platforms: multi bytes values are stored in
+little endian, except the packed calendars of packed_calendar_store, that are stored in big endian (most significant
+byte first), so that the stored bytes compare with memcmp in the same order as the times.
+
+*/
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// delta-of-delta encoding
+
+// each value is encoded as the difference between its delta to the previous value and the previous delta,
+// zigzag encoded, with a variable length prefix:
+//   0     : same delta as before (1 bit)
+//   10    : followed by 7 bits
+//   110   : followed by 9 bits
+//   1110  : followed by 12 bits
+//   11110 : followed by 32 bits
+//   11111 : followed by 64 bits
+// the first value of a stream is stored as is, on 64 bits; bits are packed starting from the least significant
+// bit of each byte.
+
+// state of a streaming dod encoder, writing into a caller owned buffer
+struct kiss_dod_encoder
+{
+    uint8_t *buffer;
+    size_t capacity;           // size of the buffer, in bytes
+    size_t n_bits;             // number of bits written so far
+    size_t n_values;           // number of values pushed so far
+    kiss_time_t previous;
+    kiss_time_t previous_delta;
+    bool overflow;             // true if the buffer was too small for some of the values
+};
+
+// start a new stream in buffer
+void dod_encoder_init(kiss_dod_encoder *const encoder, uint8_t *const buffer, size_t const capacity);
+
+// append a value to the stream
+// return true if success, false if no success (the buffer is full); once a push failed, all next pushes fail
+bool dod_encoder_push(kiss_dod_encoder *const encoder, kiss_time_t const value);
+
+// number of bytes of the buffer used by the stream so far
+size_t dod_encoder_size(kiss_dod_encoder const *const encoder);
+
+// decode n_values values from a stream written by a kiss_dod_encoder
+// return true if success, false if no success (the stream is shorter than n_values values)
+bool dod_decode_stream(uint8_t const *const buffer, size_t const size, size_t const n_values, kiss_time_t *const values_out);
+
+// encode a full series, split in independent blocks of block_length values, so that any block can be decoded
+// on its own; the layout is:
+//   uint32 n_values, uint32 block_length, uint32 offset of each block (from the end of the header), then the blocks
+// return the number of bytes written to buffer, or 0 if no success (buffer too small, block_length is 0); if no
+// success, the content of the buffer is unspecified
+size_t dod_encode(kiss_time_t const *const values, size_t const n_values, size_t const block_length,
+                  uint8_t *const buffer, size_t const capacity);
+
+// number of values, and number of blocks, in a series written by dod_encode; 0 if the buffer is not valid
+size_t dod_n_values(uint8_t const *const buffer, size_t const size);
+size_t dod_n_blocks(uint8_t const *const buffer, size_t const size);
+
+// decode a single block of a series written by dod_encode; values_out must have room for block_length values
+// return the number of values decoded, 0 if no success
+size_t dod_decode_block(uint8_t const *const buffer, size_t const size, size_t const block_index, kiss_time_t *const values_out);
+
+// decode a full series written by dod_encode; values_out must have room for max_values values
+// return the number of values decoded, 0 if no success (including if max_values is too small)
+size_t dod_decode(uint8_t const *const buffer, size_t const size, kiss_time_t *const values_out, size_t const max_values);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// frame-of-reference encoding
+
+// number of values per block; the last block of a series may be shorter
+static constexpr size_t KISS_FOR_BLOCK_LENGTH = 128;
+
+// the layout is: uint32 n_values, then for each block: uint64 reference (the minimum of the block),
+// uint8 bit width, and the offsets of the values to the reference packed on bit width bits each
+// (least significant bit of each byte first)
+
+// maximum number of bytes needed to encode n_values values
+size_t for_max_encoded_size(size_t const n_values);
+
+// encode a series
+// return the number of bytes written to buffer, or 0 if no success (buffer too small); if no success, the content
+// of the buffer is unspecified
+size_t for_encode(kiss_time_t const *const values, size_t const n_values, uint8_t *const buffer, size_t const capacity);
+
+// number of values, and number of blocks, in a series written by for_encode; 0 if the buffer is not valid
+size_t for_n_values(uint8_t const *const buffer, size_t const size);
+size_t for_n_blocks(uint8_t const *const buffer, size_t const size);
+
+// decode a single block of a series written by for_encode; values_out must have room for KISS_FOR_BLOCK_LENGTH values
+// return the number of values decoded, 0 if no success
+size_t for_decode_block(uint8_t const *const buffer, size_t const size, size_t const block_index, kiss_time_t *const values_out);
+
+// decode a full series written by for_encode; values_out must have room for max_values values
+// return the number of values decoded, 0 if no success (including if max_values is too small)
+size_t for_decode(uint8_t const *const buffer, size_t const size, kiss_time_t *const values_out, size_t const max_values);
+
+// same as for_decode, but directly decode to calendar times, block by block through posix_to_calendar_batch
+// note that this uses KISS_FOR_BLOCK_LENGTH posix times of stack
+size_t for_decode_to_calendar(uint8_t const *const buffer, size_t const size, kiss_calendar_time *const calendars_out, size_t const max_values);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// packed calendar
+
+// a calendar time packed in the 40 lowest bits of an integer, from the most significant to the least significant:
+// year - EPOCH_START on 14 bits, month on 4 bits, day on 5 bits, hour on 5 bits, minute on 6 bits, second on 6 bits;
+// since the most significant fields come first, comparing two packed calendars as integers compares them chronologically
+using kiss_packed_calendar_t = uint64_t;
+
+// the years that can be packed are EPOCH_START to KISS_PACKED_CALENDAR_MAX_YEAR
+static constexpr uint16_t KISS_PACKED_CALENDAR_MAX_YEAR = EPOCH_START + 16383;
+
+// number of bytes used by packed_calendar_store
+static constexpr size_t KISS_PACKED_CALENDAR_SIZE = 5;
+
+// pack / unpack a calendar; there are no checks, calendar_in must be valid and its year must be in the range above
+kiss_packed_calendar_t pack_calendar(kiss_calendar_time const *const calendar_in);
+void unpack_calendar(kiss_packed_calendar_t const packed_in, kiss_calendar_time *const calendar_out);
+
+// direct conversions between posix time and packed calendar
+kiss_packed_calendar_t posix_to_packed_calendar(kiss_time_t const posix_in);
+kiss_time_t packed_calendar_to_posix(kiss_packed_calendar_t const packed_in);
+
+// store / load a packed calendar to / from KISS_PACKED_CALENDAR_SIZE bytes; the bytes are stored most significant first,
+// so that stored packed calendars can also be compared and sorted with memcmp
+void packed_calendar_store(kiss_packed_calendar_t const packed_in, uint8_t *const buffer_out);
+kiss_packed_calendar_t packed_calendar_load(uint8_t const *const buffer_in);
+
+#ifdef KISS_POSIX_TIME_HEADER_ONLY
+  #include "kiss_posix_time_compression.cpp"
+#endif
+
+#endif
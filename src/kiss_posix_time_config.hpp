@@ -0,0 +1,29 @@
+#ifndef KISS_POSIX_TIME_CONFIG
+#define KISS_POSIX_TIME_CONFIG
+
+/*
+
+Build mode of the library.
+
+By default, the library is built the usual way: compile the .cpp files in the src folder together with your code
+(this is what the Arduino / PlatformIO build does on its own).
+
+If KISS_POSIX_TIME_HEADER_ONLY is defined (for example with -DKISS_POSIX_TIME_HEADER_ONLY, or by a #define before
+including any header of the library, in every translation unit), each header also pulls in its implementation,
+with all the functions declared inline: then, there is no .cpp file to compile, and the compiler can inline the
+functions at the call site, without the need for link time optimization. In this mode, do not compile the .cpp files.
+
+*/
+
+#ifdef KISS_POSIX_TIME_HEADER_ONLY
+  #define KISS_POSIX_TIME_INLINE inline
+#else
+  #define KISS_POSIX_TIME_INLINE
+#endif
+
+// 1 to use my implementation, 0 to use Oryx, for calendar_to_posix and posix_to_calendar (see kiss_posix_time_utils)
+#ifndef USE_JR_IMPLEMENTATION
+  #define USE_JR_IMPLEMENTATION 1
+#endif
+
+#endif
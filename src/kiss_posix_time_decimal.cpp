@@ -0,0 +1,381 @@
+#ifndef KISS_POSIX_TIME_DECIMAL_IMPLEMENTATION
+#define KISS_POSIX_TIME_DECIMAL_IMPLEMENTATION
+
+#include "kiss_posix_time_decimal.hpp"
+#include "kiss_posix_time_text_helpers.hpp"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// internal helpers
+
+static constexpr uint64_t DECIMAL_ZEROS     = 0x3030303030303030;    // "00000000"
+static constexpr uint64_t DECIMAL_HIGH_BITS = 0xF0F0F0F0F0F0F0F0;
+static constexpr uint32_t DECIMAL_CHUNK     = 100000000;             // 8 digits
+
+// the largest value
+static constexpr char decimal_max_text[] = "18446744073709551615";
+
+// number of lines that the calendar version of parse_epoch_lines parses to posix times on the stack, before converting
+// them in one batch; a multiple of 8, so that each chunk starts on a byte of the validity mask
+static constexpr size_t DECIMAL_LINES_PER_CHUNK = 64;
+
+// 10^i, for the number of digits of a value
+static constexpr uint64_t decimal_powers[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000, 100000000000, 1000000000000,
+    10000000000000, 100000000000000, 1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000,
+    10000000000000000000u
+};
+
+// 8 characters as a word, the first one in the lowest byte, whatever the platform; the fixed length loop is a single
+// load on little endian targets
+static uint64_t decimal_load_chunk(char const *const text_in){
+    uint64_t chunk {0};
+    for (size_t i=0; i<8; i++){
+        chunk |= static_cast<uint64_t>(static_cast<uint8_t>(text_in[i])) << (8 * i);
+    }
+    return chunk;
+}
+
+// n_chars (less than 8) characters, as the last characters of a chunk that starts with '0's
+static uint64_t decimal_load_partial_chunk(char const *const text_in, size_t const n_chars){
+    uint64_t chunk {DECIMAL_ZEROS};
+    for (size_t i=0; i<n_chars; i++){
+        chunk = (chunk >> 8) | (static_cast<uint64_t>(static_cast<uint8_t>(text_in[i])) << 56);
+    }
+    return chunk;
+}
+
+static void decimal_store_chunk(char *const buffer_out, uint64_t const chunk){
+    for (size_t i=0; i<8; i++){
+        buffer_out[i] = static_cast<char>(static_cast<uint8_t>(chunk >> (8 * i)));
+    }
+}
+
+// are the 8 characters all in '0' to '9': their high nibble is 3, and is still 3 after adding 6 to them
+// (as the high nibbles are checked first, adding 6 never carries to the next character)
+static bool decimal_chunk_is_digits(uint64_t const chunk){
+    return ((chunk & DECIMAL_HIGH_BITS) | (((chunk + 0x0606060606060606) & DECIMAL_HIGH_BITS) >> 4)) == 0x3333333333333333;
+}
+
+// one bit set in each byte of the chunk that is not a digit (the same checks as decimal_chunk_is_digits); a carry of
+// adding 6 may flag the bytes after a byte that is not a digit, but never the bytes before it
+static uint64_t decimal_chunk_non_digits(uint64_t const chunk){
+    return ((chunk & DECIMAL_HIGH_BITS) ^ 0x3030303030303030) | (((chunk + 0x0606060606060606) & DECIMAL_HIGH_BITS) ^ 0x3030303030303030);
+}
+
+// index of the lowest set bit, mask must not be 0
+static size_t decimal_lowest_bit(uint64_t const mask){
+    #if defined(__GNUC__)
+        return static_cast<size_t>(__builtin_ctzll(mask));
+    #else
+        size_t index {0};
+        while (((mask >> index) & 1) == 0){
+            index++;
+        }
+        return index;
+    #endif
+}
+
+// value of 8 digits: combine the digits in pairs, then the pairs in groups of 4, then the two groups; each step is one
+// multiplication for all the lanes of the word
+static uint32_t decimal_chunk_value(uint64_t chunk){
+    chunk -= DECIMAL_ZEROS;
+    chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FF;
+    chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFF;
+    chunk = (chunk * 10000 + (chunk >> 32)) & 0xFFFFFFFF;
+    return static_cast<uint32_t>(chunk);
+}
+
+// 8 digits of a value less than 10^8, the reverse of decimal_chunk_value: split in groups of 4, then pairs, then
+// digits, each division being a multiplication and a shift for all the lanes of the word
+static uint64_t decimal_value_chunk(uint32_t const value){
+    uint64_t chunk = (value / 10000) | (static_cast<uint64_t>(value % 10000) << 32);
+    uint64_t const hundreds = ((chunk * 10486) >> 20) & 0x0000007F0000007F;
+    chunk = hundreds | ((chunk - 100 * hundreds) << 16);
+    uint64_t const tens = ((chunk * 103) >> 10) & 0x000F000F000F000F;
+    chunk = tens | ((chunk - 10 * tens) << 8);
+    return chunk + DECIMAL_ZEROS;
+}
+
+static bool decimal_parse(char const *const text_in, size_t const length_in, uint64_t *const value_out){
+    if (length_in == 0 || length_in > 20){
+        return false;
+    }
+
+    // 20 digits may not fit: compare with the largest value first
+    if (length_in == 20){
+        for (size_t i=0; i<20; i++){
+            if (text_in[i] != decimal_max_text[i]){
+                if (text_in[i] > decimal_max_text[i]){
+                    return false;
+                }
+                break;
+            }
+        }
+    }
+
+    // the leading digits that are not a whole chunk, then whole chunks
+    size_t const n_head = length_in % 8;
+    uint64_t value {0};
+    if (n_head != 0){
+        uint64_t const chunk = decimal_load_partial_chunk(text_in, n_head);
+        if (!decimal_chunk_is_digits(chunk)){
+            return false;
+        }
+        value = decimal_chunk_value(chunk);
+    }
+    for (size_t position=n_head; position<length_in; position+=8){
+        uint64_t const chunk = decimal_load_chunk(text_in + position);
+        if (!decimal_chunk_is_digits(chunk)){
+            return false;
+        }
+        value = value * DECIMAL_CHUNK + decimal_chunk_value(chunk);
+    }
+
+    *value_out = value;
+    return true;
+}
+
+// read the digits in a row from position, 8 at a time while there are 8 characters left in the buffer, and return their
+// number; value_out is their value if there are less than 20 of them (else, it is meaningless)
+static size_t decimal_read_run(char const *const buffer_in, size_t const buffer_size, size_t const position, uint64_t *const value_out){
+    size_t end {position};
+    uint64_t value {0};
+
+    while (end + 8 <= buffer_size){
+        uint64_t const chunk = decimal_load_chunk(buffer_in + end);
+        uint64_t const non_digits = decimal_chunk_non_digits(chunk);
+        if (non_digits != 0){
+            // the digits before the first character that is not one, moved to the end of a chunk of '0's
+            size_t const n_digits = decimal_lowest_bit(non_digits) / 8;
+            if (n_digits != 0){
+                uint64_t const digits = (chunk << (8 * (8 - n_digits))) | (DECIMAL_ZEROS >> (8 * n_digits));
+                value = value * decimal_powers[n_digits] + decimal_chunk_value(digits);
+            }
+            *value_out = value;
+            return end + n_digits - position;
+        }
+        value = value * DECIMAL_CHUNK + decimal_chunk_value(chunk);
+        end += 8;
+    }
+
+    while (end < buffer_size && static_cast<uint8_t>(buffer_in[end] - '0') <= 9){
+        value = value * 10 + static_cast<uint8_t>(buffer_in[end] - '0');
+        end++;
+    }
+    *value_out = value;
+    return end - position;
+}
+
+static size_t decimal_n_digits(uint64_t const value){
+    size_t n_digits {1};
+    while (n_digits < 20 && value >= decimal_powers[n_digits]){
+        n_digits++;
+    }
+    return n_digits;
+}
+
+// write the n_digits digits of value (no null byte); n_digits must be those of decimal_n_digits
+static void decimal_write(char *const buffer_out, uint64_t value, size_t const n_digits){
+    // whole chunks from the end, then the leading digits through a scratch chunk
+    size_t position {n_digits};
+    while (position > 8){
+        position -= 8;
+        decimal_store_chunk(buffer_out + position, decimal_value_chunk(static_cast<uint32_t>(value % DECIMAL_CHUNK)));
+        value /= DECIMAL_CHUNK;
+    }
+
+    char head[8];
+    decimal_store_chunk(head, decimal_value_chunk(static_cast<uint32_t>(value)));
+    for (size_t i=0; i<position; i++){
+        buffer_out[i] = head[8 - position + i];
+    }
+}
+
+static size_t decimal_print(uint64_t const value, char *const buffer_out, size_t const buffer_size){
+    size_t const n_digits = decimal_n_digits(value);
+
+    // check that we have a buffer large enough; if not, return 0 and fill with null bytes
+    if (buffer_size < n_digits + 1){
+        for (size_t i=0; i<buffer_size; i++){
+            buffer_out[i] = '\0';
+        }
+        return 0;
+    }
+
+    decimal_write(buffer_out, value, n_digits);
+    buffer_out[n_digits] = '\0';
+    return n_digits;
+}
+
+// parse the line starting at position; next_out is the start of the next line
+// the digits are read 8 at a time, and if they make the whole line (the usual case), the end of the line is right
+// after them; otherwise the line is not valid, and is skipped character by character
+static bool decimal_parse_line(char const *const buffer_in, size_t const buffer_size, size_t const position,
+                               kiss_time_t *const posix_out, size_t *const next_out){
+    uint64_t value {0};
+    size_t const n_digits = decimal_read_run(buffer_in, buffer_size, position, &value);
+    size_t const end = position + n_digits;
+
+    bool at_end_of_line {true};
+    if (end == buffer_size){
+        *next_out = end;
+    }
+    else if (buffer_in[end] == '\n'){
+        *next_out = end + 1;
+    }
+    else if (buffer_in[end] == '\r' && (end + 1 == buffer_size || buffer_in[end + 1] == '\n')){
+        *next_out = (end + 1 == buffer_size) ? end + 1 : end + 2;
+    }
+    else{
+        at_end_of_line = false;
+    }
+
+    if (!at_end_of_line){
+        size_t next {end};
+        while (next < buffer_size && buffer_in[next] != '\n'){
+            next++;
+        }
+        *next_out = (next < buffer_size) ? next + 1 : next;
+        return false;
+    }
+
+    // 20 digits or more need the overflow checks of decimal_parse
+    if (n_digits == 0){
+        return false;
+    }
+    if (n_digits >= 20){
+        return decimal_parse(buffer_in + position, n_digits, posix_out);
+    }
+    *posix_out = value;
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// functions
+
+KISS_POSIX_TIME_INLINE bool parse_epoch(char const *const text_in, size_t const length_in, kiss_time_t *const posix_out){
+    return decimal_parse(text_in, length_in, posix_out);
+}
+
+KISS_POSIX_TIME_INLINE bool parse_epoch(char const *const text_in, size_t const length_in, kiss_calendar_time *const calendar_out){
+    kiss_time_t posix {0};
+    if (!decimal_parse(text_in, length_in, &posix) || posix > LAST_POSIX_IN_CALENDAR_TIME){
+        return false;
+    }
+    posix_to_calendar(posix, calendar_out);
+    return true;
+}
+
+KISS_POSIX_TIME_INLINE bool parse_epoch_milliseconds(char const *const text_in, size_t const length_in, kiss_time_t *const posix_out, uint16_t *const milliseconds_out){
+    uint64_t milliseconds {0};
+    if (!decimal_parse(text_in, length_in, &milliseconds)){
+        return false;
+    }
+    *posix_out = milliseconds / 1000;
+    *milliseconds_out = static_cast<uint16_t>(milliseconds % 1000);
+    return true;
+}
+
+KISS_POSIX_TIME_INLINE size_t parse_epoch_lines(char const *const buffer_in, size_t const buffer_size, kiss_time_t *const posix_out,
+                                                uint8_t *const valid_mask_out, size_t const max_lines, size_t *const n_bytes_out){
+    size_t position {0};
+    size_t n_lines {0};
+
+    while (position < buffer_size && n_lines < max_lines){
+        kiss_time_t posix {0};
+        size_t next {0};
+        bool const valid = decimal_parse_line(buffer_in, buffer_size, position, &posix, &next);
+        posix_out[n_lines] = posix;
+        text_set_valid(valid_mask_out, n_lines, valid);
+
+        n_lines++;
+        position = next;
+    }
+
+    *n_bytes_out = position;
+    return n_lines;
+}
+
+KISS_POSIX_TIME_INLINE size_t parse_epoch_lines(char const *const buffer_in, size_t const buffer_size, kiss_calendar_time *const calendar_out,
+                                                uint8_t *const valid_mask_out, size_t const max_lines, size_t *const n_bytes_out){
+    kiss_time_t working_posix[DECIMAL_LINES_PER_CHUNK];
+    size_t n_lines {0};
+    size_t position {0};
+
+    while (position < buffer_size && n_lines < max_lines){
+        size_t const n_wanted = (max_lines - n_lines < DECIMAL_LINES_PER_CHUNK) ? max_lines - n_lines : DECIMAL_LINES_PER_CHUNK;
+        uint8_t *const chunk_mask = &valid_mask_out[n_lines / 8];
+        size_t n_bytes {0};
+        size_t const n_chunk_lines = parse_epoch_lines(buffer_in + position, buffer_size - position, working_posix, chunk_mask, n_wanted, &n_bytes);
+
+        // the times after year 65535 are not valid either; they are converted as 0, and then cleared with the others
+        for (size_t i=0; i<n_chunk_lines; i++){
+            if (working_posix[i] > LAST_POSIX_IN_CALENDAR_TIME){
+                working_posix[i] = 0;
+                chunk_mask[i / 8] = static_cast<uint8_t>(chunk_mask[i / 8] & ~(1u << (i % 8)));
+            }
+        }
+        posix_to_calendar_batch(working_posix, &calendar_out[n_lines], n_chunk_lines);
+        for (size_t i=0; i<n_chunk_lines; i++){
+            if ((chunk_mask[i / 8] & (1u << (i % 8))) == 0){
+                calendar_out[n_lines + i] = kiss_calendar_time {0, 0, 0, 0, 0, 0};
+            }
+        }
+
+        n_lines += n_chunk_lines;
+        position += n_bytes;
+    }
+
+    *n_bytes_out = position;
+    return n_lines;
+}
+
+KISS_POSIX_TIME_INLINE size_t print_epoch(kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size){
+    return decimal_print(posix_in, buffer_out, buffer_size);
+}
+
+KISS_POSIX_TIME_INLINE size_t print_epoch(kiss_calendar_time const *const calendar_in, char *const buffer_out, size_t const buffer_size){
+    return decimal_print(calendar_to_posix(calendar_in), buffer_out, buffer_size);
+}
+
+KISS_POSIX_TIME_INLINE size_t print_epoch_milliseconds(kiss_time_t const posix_in, uint16_t const milliseconds_in, char *const buffer_out, size_t const buffer_size){
+    // the number of milliseconds must fit in 64 bits; if not, return 0 and fill with null bytes
+    if (milliseconds_in >= 1000 || posix_in > (UINT64_MAX - milliseconds_in) / 1000){
+        for (size_t i=0; i<buffer_size; i++){
+            buffer_out[i] = '\0';
+        }
+        return 0;
+    }
+    return decimal_print(posix_in * 1000 + milliseconds_in, buffer_out, buffer_size);
+}
+
+KISS_POSIX_TIME_INLINE size_t print_epoch_arena(kiss_time_t const *const posix_in, size_t const n_entries, kiss_text_arena *const arena, kiss_text_view *const views_out){
+    for (size_t i=0; i<n_entries; i++){
+        size_t const n_digits = decimal_n_digits(posix_in[i]);
+        if (arena->capacity - arena->size < n_digits){
+            return i;
+        }
+        decimal_write(arena->buffer + arena->size, posix_in[i], n_digits);
+        views_out[i] = kiss_text_view {arena->size, n_digits};
+        arena->size += n_digits;
+    }
+    return n_entries;
+}
+
+KISS_POSIX_TIME_INLINE size_t print_epoch_arena(kiss_calendar_time const *const calendar_in, size_t const n_entries, kiss_text_arena *const arena, kiss_text_view *const views_out){
+    for (size_t i=0; i<n_entries; i++){
+        kiss_time_t const posix = calendar_to_posix(&calendar_in[i]);
+        size_t const n_digits = decimal_n_digits(posix);
+        if (arena->capacity - arena->size < n_digits){
+            return i;
+        }
+        decimal_write(arena->buffer + arena->size, posix, n_digits);
+        views_out[i] = kiss_text_view {arena->size, n_digits};
+        arena->size += n_digits;
+    }
+    return n_entries;
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef KISS_POSIX_TIME_DECIMAL
+#define KISS_POSIX_TIME_DECIMAL
+
+#include "kiss_posix_time_utils.hpp"
+#include "kiss_posix_time_extras.hpp"
+
+/*
+
+Parsing and printing of posix times written as decimal integers ("epoch seconds" or "epoch milliseconds"), as in
+many logs, CSV files and JSON documents.
+
+The digits are handled 8 at a time as a single 64 bits word (SWAR: SIMD within a register): one check that all the 8
+characters are digits, and 3 multiplications to get their value; and the reverse for printing. This is portable C++,
+with no intrinsics: the words are always built in little endian order, which compiles to a plain load / store on little
+endian targets.
+
+The calendar versions are fused with the conversions: the text goes to / comes from a kiss_calendar_time directly, with
+no intermediate string to integer step left to the caller.
+
+*/
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// functions
+
+// parse exactly length_in characters (no null byte needed), 1 to 20 decimal digits, leading zeros allowed
+// return true if success, false if the text is empty, has a character that is not a digit, or is too large (then,
+// the output is not written to); the calendar version also fails for times after year 65535
+bool parse_epoch(char const *const text_in, size_t const length_in, kiss_time_t *const posix_out);
+bool parse_epoch(char const *const text_in, size_t const length_in, kiss_calendar_time *const calendar_out);
+
+// same as parse_epoch, for a number of milliseconds since the epoch, split into seconds and milliseconds
+bool parse_epoch_milliseconds(char const *const text_in, size_t const length_in, kiss_time_t *const posix_out, uint16_t *const milliseconds_out);
+
+// parse the lines of a buffer, separated by '\n' (a '\r' before it is ignored, and the last line does not need one),
+// with one time per line, up to max_lines lines; bit i % 8 of valid_mask_out[i / 8] is set if line i is valid, and the
+// output is 0 (posix) or all zeros (calendar) for the lines that are not
+// return the number of lines read; n_bytes_out is the number of bytes of the buffer they took, so that the rest can
+// be parsed in a next call if there were more than max_lines lines
+size_t parse_epoch_lines(char const *const buffer_in, size_t const buffer_size, kiss_time_t *const posix_out,
+                         uint8_t *const valid_mask_out, size_t const max_lines, size_t *const n_bytes_out);
+size_t parse_epoch_lines(char const *const buffer_in, size_t const buffer_size, kiss_calendar_time *const calendar_out,
+                         uint8_t *const valid_mask_out, size_t const max_lines, size_t *const n_bytes_out);
+
+// print a time as decimal digits, without leading zeros, null terminated
+// the buffer size must be at least the number of digits + 1 (21 is always enough)
+// return the number of characters written (not counting the null byte), or 0 if the buffer is too small (then, the
+// buffer is filled with null bytes)
+size_t print_epoch(kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size);
+size_t print_epoch(kiss_calendar_time const *const calendar_in, char *const buffer_out, size_t const buffer_size);
+
+// same as print_epoch, for a number of milliseconds since the epoch
+// also return 0 (and fill the buffer with null bytes) if milliseconds_in is 1000 or more, or if the number of
+// milliseconds does not fit in 64 bits (posix_in after 18446744073709551, with up to 615 milliseconds)
+size_t print_epoch_milliseconds(kiss_time_t const posix_in, uint16_t const milliseconds_in, char *const buffer_out, size_t const buffer_size);
+
+// print n_entries times as decimal digits (as print_epoch, no null byte) to an arena (see kiss_posix_time_extras), with
+// their views
+// return the number of entries printed, that is less than n_entries only if the arena is full
+size_t print_epoch_arena(kiss_time_t const *const posix_in, size_t const n_entries, kiss_text_arena *const arena, kiss_text_view *const views_out);
+size_t print_epoch_arena(kiss_calendar_time const *const calendar_in, size_t const n_entries, kiss_text_arena *const arena, kiss_text_view *const views_out);
+
+#ifdef KISS_POSIX_TIME_HEADER_ONLY
+  #include "kiss_posix_time_decimal.cpp"
+#endif
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef KISS_POSIX_TIME_ERA_HELPERS
+#define KISS_POSIX_TIME_ERA_HELPERS
+
+#include "kiss_posix_time_utils.hpp"
+
+/*
+
+Internal helpers shared by the modules that go from days to calendar dates in O(1) (utils, series), with the era
+algorithms by Howard Hinnant; this is not part of the API. Everything here is inline, so that this is header only, also
+when the library is compiled.
+
+*/
+
+// number of days from 0000-03-01 to 1970-01-01, the start of the years counted from 1st march below
+static constexpr uint64_t DAYS_FROM_0000_03_01_TO_EPOCH = 719468;
+
+// the "civil from days" algorithm, http://howardhinnant.github.io/date_algorithms.html : years are counted from
+// 1st march, so that the leap day is the last day of the year, and in eras of 400 years, that all have 146097 days; no
+// loop and no table, and the same time whatever the date
+// days_in is the number of days since 0000-03-01; year_out is the year in which the 1st march year starts, and
+// day_of_year_out is 0 for 1st march, ..., 305 for 1st january (of year_out + 1), ..., 365 for 29th february
+inline void era_days_to_march_year(uint64_t const days_in, uint64_t *const year_out, uint64_t *const day_of_year_out){
+    uint64_t const era = days_in / 146097;
+    uint64_t const day_of_era = days_in - era * 146097;                                                                   // 0 to 146096
+    uint64_t const year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;    // 0 to 399
+    *day_of_year_out = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);                          // 0 to 365
+    *year_out = era * 400 + year_of_era;
+}
+
+#endif
@@ -1,6 +1,30 @@
+#ifndef KISS_POSIX_TIME_EXTRAS_IMPLEMENTATION
+#define KISS_POSIX_TIME_EXTRAS_IMPLEMENTATION
+
 #include "kiss_posix_time_extras.hpp"
+#include "kiss_posix_time_instrumentation.hpp"
+#include "kiss_posix_time_text_helpers.hpp"
+
+// write the 19 characters of the ISO8601 string of calendar_in to buffer_out; no null byte
+static void extras_write_iso(char *const buffer_out, kiss_calendar_time const *const calendar_in){
+    // this is easy, the format is completely fixed
+    text_write_digits(&buffer_out[0], calendar_in->year, 4);
+    buffer_out[4] = '-';
+    text_write_digits(&buffer_out[5], calendar_in->month, 2);
+    buffer_out[7] = '-';
+    text_write_digits(&buffer_out[8], calendar_in->day, 2);
+    buffer_out[10] = 'T';
+    text_write_digits(&buffer_out[11], calendar_in->hour, 2);
+    buffer_out[13] = ':';
+    text_write_digits(&buffer_out[14], calendar_in->minute, 2);
+    buffer_out[16] = ':';
+    text_write_digits(&buffer_out[17], calendar_in->second, 2);
+}
+
+KISS_POSIX_TIME_INLINE bool print_iso(kiss_calendar_time const *const calendar_in, char *const buffer_out, size_t const buffer_size){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_PRINT_ISO, 1);
+    KISS_INSTRUMENT_TIMER_START(instrumentation_start);
 
-bool print_iso(kiss_calendar_time const *const calendar_in, char *const buffer_out, size_t const buffer_size){
     // check that we have a buffer large enough for all uses; if not, return false and fill with null bytes
     if (buffer_size < 20){
         for (size_t i=0; i<buffer_size; i++){
@@ -9,28 +33,243 @@ bool print_iso(kiss_calendar_time const *const calendar_in, char *const buffer_o
         return false;
     }
 
-    // start filling... this is easy, the format is completely fixed
-    snprintf(&buffer_out[0], 4+1, "%04u", calendar_in->year);
-    buffer_out[4] = '-';
-    snprintf(&buffer_out[5], 2+1, "%02u", calendar_in->month);
-    buffer_out[7] = '-';
-    snprintf(&buffer_out[8], 2+1, "%02u", calendar_in->day);
-    buffer_out[10] = 'T';
-    snprintf(&buffer_out[11], 2+1, "%02u", calendar_in->hour);
-    buffer_out[13] = ':';
-    snprintf(&buffer_out[14], 2+1, "%02u", calendar_in->minute);
-    buffer_out[16] = ':';
-    snprintf(&buffer_out[17], 2+1, "%02u", calendar_in->second);
+    extras_write_iso(buffer_out, calendar_in);
 
     // end with null byte always
+    buffer_out[19] = '\0';
     buffer_out[buffer_size-1] = '\0';
 
+    KISS_INSTRUMENT_TIMER_STOP(KISS_TIMER_PRINT_ISO, instrumentation_start);
     return true;
 }
 
-bool print_iso(kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size){
+KISS_POSIX_TIME_INLINE bool print_iso(kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size){
     kiss_calendar_time working_calendar;
     posix_to_calendar(posix_in, &working_calendar);
     bool result = print_iso(&working_calendar, buffer_out, buffer_size);
     return result;
 }
+
+// increment a 2 digits field in place, from 00 up to (not including) the limit; return false, and write 00, on wrap around
+static bool extras_increment_digits(char *const buffer_out, uint8_t *const field, uint8_t const limit){
+    if (*field + 1 == limit){
+        *field = 0;
+        buffer_out[0] = '0';
+        buffer_out[1] = '0';
+        return false;
+    }
+
+    (*field)++;
+    if (buffer_out[1] != '9'){
+        buffer_out[1]++;
+    }
+    else{
+        buffer_out[1] = '0';
+        buffer_out[0]++;
+    }
+    return true;
+}
+
+// rewrite a 2 digits field only if it changed
+static void extras_update_digits(char *const buffer_out, uint8_t *const field, uint8_t const value){
+    if (*field != value){
+        *field = value;
+        text_write_digits(buffer_out, value, 2);
+    }
+}
+
+KISS_POSIX_TIME_INLINE void iso_formatter_init(kiss_iso_formatter *const formatter){
+    formatter->posix = 0;
+    formatter->day_start = 0;
+    formatter->calendar = kiss_calendar_time {EPOCH_START, 1, 1, 0, 0, 0};
+    formatter->buffer[0] = '\0';
+    formatter->valid = false;
+}
+
+KISS_POSIX_TIME_INLINE char const *iso_formatter_print(kiss_iso_formatter *const formatter, kiss_time_t const posix_in){
+    char *const buffer = formatter->buffer;
+    kiss_calendar_time *const calendar = &formatter->calendar;
+
+    if (formatter->valid){
+        // the next second: increment the digits, with carry through the minutes and hours
+        if (posix_in == formatter->posix + 1){
+            formatter->posix = posix_in;
+            if (extras_increment_digits(&buffer[17], &calendar->second, 60) || extras_increment_digits(&buffer[14], &calendar->minute, 60)
+                || extras_increment_digits(&buffer[11], &calendar->hour, 24)){
+                return buffer;
+            }
+            // a new day: fall through to a full print below
+        }
+        // the same day: the date does not change
+        else if (posix_in >= formatter->day_start && posix_in - formatter->day_start < SECS_PER_DAY){
+            uint32_t const seconds_in_day = static_cast<uint32_t>(posix_in - formatter->day_start);
+            formatter->posix = posix_in;
+            extras_update_digits(&buffer[11], &calendar->hour, static_cast<uint8_t>(seconds_in_day / 3600));
+            extras_update_digits(&buffer[14], &calendar->minute, static_cast<uint8_t>(seconds_in_day / 60 % 60));
+            extras_update_digits(&buffer[17], &calendar->second, static_cast<uint8_t>(seconds_in_day % 60));
+            return buffer;
+        }
+    }
+
+    formatter->posix = posix_in;
+    formatter->day_start = posix_in - posix_in % SECS_PER_DAY;
+    posix_to_calendar(posix_in, calendar);
+    print_iso(calendar, buffer, 20);
+    formatter->valid = true;
+    return buffer;
+}
+
+// 10^i, to truncate the nanoseconds to the fractional digits
+static constexpr uint32_t extras_powers_of_10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+// the local time that an RFC 3339 string shows; return false if it cannot be printed (options out of range, time
+// before the epoch once shifted by the offset, or a year after 9999)
+static bool extras_rfc3339_local(kiss_time_t const posix_in, uint32_t const nanoseconds_in, kiss_rfc3339_options const *const options,
+                                 kiss_time_t *const local_out){
+    if (options->n_fraction_digits > 9 || nanoseconds_in >= 1000000000 || options->offset_minutes < -1439 || options->offset_minutes > 1439){
+        return false;
+    }
+
+    kiss_time_t local {posix_in};
+    if (options->offset_minutes < 0){
+        kiss_time_t const shift = static_cast<kiss_time_t>(-options->offset_minutes) * SECS_PER_MIN;
+        if (posix_in < shift){
+            return false;
+        }
+        local = posix_in - shift;
+    }
+    else{
+        local = posix_in + static_cast<kiss_time_t>(options->offset_minutes) * SECS_PER_MIN;
+    }
+
+    if (posix_in >= FIRST_POSIX_OF_YEAR_10000 || local >= FIRST_POSIX_OF_YEAR_10000){
+        return false;
+    }
+    *local_out = local;
+    return true;
+}
+
+// write the RFC 3339 string of a local time from extras_rfc3339_local; no null byte
+// return the number of characters written, that is rfc3339_size(options)
+static size_t extras_write_rfc3339(char *const buffer_out, kiss_time_t const local_in, uint32_t const nanoseconds_in,
+                                   kiss_rfc3339_options const *const options){
+    kiss_calendar_time calendar;
+    posix_to_calendar(local_in, &calendar);
+    extras_write_iso(buffer_out, &calendar);
+    size_t length {19};
+
+    // the fraction is truncated, not rounded, so that the seconds never change
+    uint8_t const n_fraction_digits = options->n_fraction_digits;
+    if (n_fraction_digits != 0){
+        buffer_out[length] = '.';
+        text_write_digits(&buffer_out[length + 1], nanoseconds_in / extras_powers_of_10[9 - n_fraction_digits], n_fraction_digits);
+        length += 1 + n_fraction_digits;
+    }
+
+    if (options->offset_minutes == 0){
+        buffer_out[length] = 'Z';
+        return length + 1;
+    }
+
+    uint16_t const offset = static_cast<uint16_t>(options->offset_minutes < 0 ? -options->offset_minutes : options->offset_minutes);
+    buffer_out[length] = (options->offset_minutes < 0) ? '-' : '+';
+    text_write_digits(&buffer_out[length + 1], offset / 60u, 2);
+    buffer_out[length + 3] = ':';
+    text_write_digits(&buffer_out[length + 4], offset % 60u, 2);
+    return length + 6;
+}
+
+KISS_POSIX_TIME_INLINE size_t rfc3339_size(kiss_rfc3339_options const *const options){
+    return 19 + ((options->n_fraction_digits != 0) ? 1u + options->n_fraction_digits : 0u) + ((options->offset_minutes == 0) ? 1u : 6u);
+}
+
+KISS_POSIX_TIME_INLINE size_t print_rfc3339(kiss_time_t const posix_in, uint32_t const nanoseconds_in, kiss_rfc3339_options const *const options,
+                                            char *const buffer_out, size_t const buffer_size){
+    // check that we have a buffer large enough, and a time that can be printed; if not, return 0 and fill with null bytes
+    kiss_time_t local {0};
+    if (buffer_size < rfc3339_size(options) + 1 || !extras_rfc3339_local(posix_in, nanoseconds_in, options, &local)){
+        for (size_t i=0; i<buffer_size; i++){
+            buffer_out[i] = '\0';
+        }
+        return 0;
+    }
+
+    size_t const length = extras_write_rfc3339(buffer_out, local, nanoseconds_in, options);
+    buffer_out[length] = '\0';
+    return length;
+}
+
+KISS_POSIX_TIME_INLINE size_t print_rfc3339_arena(kiss_time_t const *const posix_in, uint32_t const *const nanoseconds_in, size_t const n_entries,
+                                                  kiss_rfc3339_options const *const options, kiss_text_arena *const arena, kiss_text_view *const views_out){
+    // all the strings have the same size: as many entries as fit, decided once for the whole batch
+    size_t const size = rfc3339_size(options);
+    size_t const n_fit = (arena->capacity - arena->size) / size;
+    size_t const n_print = (n_entries < n_fit) ? n_entries : n_fit;
+
+    for (size_t i=0; i<n_print; i++){
+        uint32_t const nanoseconds = (nanoseconds_in != nullptr) ? nanoseconds_in[i] : 0;
+        kiss_time_t local {0};
+        if (!extras_rfc3339_local(posix_in[i], nanoseconds, options, &local)){
+            return i;
+        }
+        extras_write_rfc3339(arena->buffer + arena->size, local, nanoseconds, options);
+        views_out[i] = kiss_text_view {arena->size, size};
+        arena->size += size;
+    }
+
+    return n_print;
+}
+
+KISS_POSIX_TIME_INLINE void text_arena_init(kiss_text_arena *const arena, char *const buffer, size_t const capacity){
+    arena->buffer = buffer;
+    arena->capacity = capacity;
+    arena->size = 0;
+}
+
+KISS_POSIX_TIME_INLINE void text_arena_clear(kiss_text_arena *const arena){
+    arena->size = 0;
+}
+
+KISS_POSIX_TIME_INLINE size_t print_iso_arena(kiss_calendar_time const *const calendar_in, size_t const n_entries, kiss_text_arena *const arena, kiss_text_view *const views_out){
+    // as many entries as fit, decided once for the whole batch
+    size_t const n_fit = (arena->capacity - arena->size) / 19;
+    size_t const n_print = (n_entries < n_fit) ? n_entries : n_fit;
+
+    char *position = arena->buffer + arena->size;
+    for (size_t i=0; i<n_print; i++){
+        extras_write_iso(position, &calendar_in[i]);
+        views_out[i] = kiss_text_view {arena->size + 19 * i, 19};
+        position += 19;
+    }
+
+    arena->size += 19 * n_print;
+    return n_print;
+}
+
+KISS_POSIX_TIME_INLINE size_t print_iso_arena(kiss_time_t const *const posix_in, size_t const n_entries, kiss_text_arena *const arena, kiss_text_view *const views_out){
+    size_t const n_fit = (arena->capacity - arena->size) / 19;
+    size_t const n_print = (n_entries < n_fit) ? n_entries : n_fit;
+
+    char *position = arena->buffer + arena->size;
+    kiss_calendar_time working_calendar;
+    for (size_t i=0; i<n_print; i++){
+        posix_to_calendar(posix_in[i], &working_calendar);
+        extras_write_iso(position, &working_calendar);
+        views_out[i] = kiss_text_view {arena->size + 19 * i, 19};
+        position += 19;
+    }
+
+    arena->size += 19 * n_print;
+    return n_print;
+}
+
+KISS_POSIX_TIME_INLINE uint8_t day_of_week(kiss_time_t const posix_in){
+    // 1st jan 1970 was a thursday
+    return static_cast<uint8_t>( (posix_in / SECS_PER_DAY + 3) % 7 + 1 );
+}
+
+KISS_POSIX_TIME_INLINE uint8_t day_of_week(kiss_calendar_time const *const calendar_in){
+    return day_of_week(calendar_to_posix(calendar_in));
+}
+
+#endif
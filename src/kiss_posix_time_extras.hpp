@@ -5,6 +5,9 @@
 
 #ifndef ARDUINO
   #include <cstdio>
+  #if __cplusplus >= 201703L
+    #include <string_view>
+  #endif
 #endif
 
 
@@ -39,6 +42,43 @@ static char const *const month_names[] = {
   "December"
 };
 
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// data structures
+
+// state of an incremental ISO formatter, see iso_formatter_print
+struct kiss_iso_formatter
+{
+    kiss_time_t posix;                // last formatted time
+    kiss_time_t day_start;            // posix time of the start of its day
+    kiss_calendar_time calendar;      // its calendar
+    char buffer[20];                  // its ISO string, null terminated
+    bool valid;                       // false until the first print
+};
+
+// a slab of memory, provided by the caller, that the bulk formatting functions append strings to; the strings are
+// not null terminated, and are found with kiss_text_view. Clear the arena to reuse the same memory for the next batch.
+struct kiss_text_arena
+{
+    char *buffer;
+    size_t capacity;
+    size_t size;       // number of bytes used
+};
+
+// a string in a kiss_text_arena: the characters buffer[offset] to buffer[offset + length - 1]
+struct kiss_text_view
+{
+    size_t offset;
+    size_t length;
+};
+
+// how to print RFC 3339 strings, for example 2020-03-20T14:28:23.125Z or 2020-03-20T16:28:23+02:00
+struct kiss_rfc3339_options
+{
+    uint8_t n_fraction_digits;    // digits after the seconds, 0 to 9 (usually 0, 3, 6 or 9); 0 has no '.'
+    int16_t offset_minutes;       // offset of the printed local time to UTC, -1439 to 1439; 0 prints 'Z'
+};
+
 //////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////
 // functions
@@ -50,13 +90,59 @@ static char const *const month_names[] = {
 bool print_iso(kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size);
 bool print_iso(kiss_calendar_time const *const calendar_in, char *const buffer_out, size_t const buffer_size);
 
-// TODO: implement all under (if there is some demand for it!)
+// print ISO8601 with second precision, like print_iso, for a stream of times that are mostly close to each other
+// (for example, sorted log timestamps): only the characters that change since the previous print are rewritten. The
+// next second is a carry propagating increment of the digits, any time within the same day rewrites the changed time
+// fields only, and anything else is formatted in full.
+// the formatter must be initialized with iso_formatter_init; the output is formatter->buffer, that is also returned,
+// and stays valid until the next print with the same formatter
+void iso_formatter_init(kiss_iso_formatter *const formatter);
+char const *iso_formatter_print(kiss_iso_formatter *const formatter, kiss_time_t const posix_in);
+
+// bulk formatting into an arena, without any allocation nor any copy of the strings: the arena is used from its
+// current size on, and does not need to be empty
+void text_arena_init(kiss_text_arena *const arena, char *const buffer, size_t const capacity);
+void text_arena_clear(kiss_text_arena *const arena);
+
+// print n_entries ISO8601 strings (as print_iso, 19 characters each, no null byte) to the arena, with their views
+// return the number of entries printed, that is less than n_entries only if the arena is full
+size_t print_iso_arena(kiss_time_t const *const posix_in, size_t const n_entries, kiss_text_arena *const arena, kiss_text_view *const views_out);
+size_t print_iso_arena(kiss_calendar_time const *const calendar_in, size_t const n_entries, kiss_text_arena *const arena, kiss_text_view *const views_out);
+
+// number of characters of the RFC 3339 strings with these options, not counting the null byte; it does not depend on
+// the time: 20 with 'Z', 25 with an offset, plus 1 + n_fraction_digits if there is a fraction
+size_t rfc3339_size(kiss_rfc3339_options const *const options);
+
+// print an RFC 3339 (and ISO 8601) string, in a single pass, null terminated: the time in UTC shifted by the offset,
+// with nanoseconds_in (less than 10^9) truncated to the fractional digits, and the 'Z' or offset suffix
+// the buffer size must be at least rfc3339_size(options) + 1
+// return the number of characters written (not counting the null byte), or 0 if the buffer is too small, the options
+// or nanoseconds_in are out of range, or the local time is before the epoch or after year 9999 (then, the buffer is
+// filled with null bytes)
+size_t print_rfc3339(kiss_time_t const posix_in, uint32_t const nanoseconds_in, kiss_rfc3339_options const *const options,
+                     char *const buffer_out, size_t const buffer_size);
+
+// print n_entries RFC 3339 strings (as print_rfc3339, rfc3339_size(options) characters each, no null byte) to the
+// arena, with their views; nanoseconds_in may be nullptr for no fractions (then, the fraction digits are 0s)
+// return the number of entries printed, that is less than n_entries only if the arena is full or an entry cannot be
+// printed
+size_t print_rfc3339_arena(kiss_time_t const *const posix_in, uint32_t const *const nanoseconds_in, size_t const n_entries,
+                           kiss_rfc3339_options const *const options, kiss_text_arena *const arena, kiss_text_view *const views_out);
+
+#if !defined(ARDUINO) && __cplusplus >= 201703L
+// a string of an arena as a std::string_view, valid until the arena is cleared
+inline std::string_view text_view_string(kiss_text_arena const *const arena, kiss_text_view const *const view){
+    return std::string_view(arena->buffer + view->offset, view->length);
+}
+#endif
 
 // what is the current week day number associated with a calendar entry?
 // 1 is monday, 2 is tuesday, ..., 7 is sunday
 uint8_t day_of_week(kiss_time_t const posix_in);
 uint8_t day_of_week(kiss_calendar_time const *const calendar_in);
 
+// TODO: implement all under (if there is some demand for it!)
+
 // which week number are we within the current year?
 // i.e. 1 is first week, 2 is second week, ..., 52 is 52nd
 uint8_t week_of_year(kiss_time_t const posix_in);
@@ -69,4 +155,8 @@ uint8_t week_of_year(kiss_calendar_time const *const calendar_in);
 bool print_plaintext(kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size);
 bool print_plaintext(kiss_calendar_time const *const calendar_in, char *const buffer_out, size_t const buffer_size);
 
+#ifdef KISS_POSIX_TIME_HEADER_ONLY
+  #include "kiss_posix_time_extras.cpp"
+#endif
+
 #endif
@@ -0,0 +1,366 @@
+#ifndef KISS_POSIX_TIME_FIXED_FORMAT
+#define KISS_POSIX_TIME_FIXED_FORMAT
+
+#include "kiss_posix_time_utils.hpp"
+#include "kiss_posix_time_extras.hpp"
+#include "kiss_posix_time_format.hpp"
+#include "kiss_posix_time_text_helpers.hpp"
+
+/*
+
+Formatting and parsing with a pattern known at compile time: the pattern is a template parameter, and the compiler
+generates a formatter and a parser unrolled for exactly this layout, with all the output positions known in advance.
+This is for fixed layouts, like the timestamps of log lines; see kiss_posix_time_format for patterns only known at
+run time.
+
+The pattern is a pointer to a constexpr null terminated array with static storage duration, for example:
+
+    static constexpr char log_pattern[] = "%Y-%m-%d %H:%M:%S";
+    char line[fixed_format_size<log_pattern>()];
+    fixed_format_print<log_pattern>(posix, line);
+
+Only the conversions of kiss_posix_time_format that have a fixed width are available, so that the output size is a
+compile time constant: %Y (4 digits; as print_iso, years after 9999 are not supported), %y, %m, %d, %H, %M, %S, %j,
+%a, %b, %u and %%. Any other conversion is a compile error.
+
+This needs C++17 (it is empty for older standards), and is header only: there is no matching .cpp file.
+
+*/
+
+#if __cplusplus >= 201703L
+
+#include <utility>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// data structures
+
+// the ISO8601 layout of print_iso
+static constexpr char KISS_FIXED_FORMAT_ISO[] = "%Y-%m-%dT%H:%M:%S";
+
+// one op of a fixed pattern: a literal character, or a conversion (the op codes of kiss_posix_time_format)
+struct kiss_fixed_format_op
+{
+    uint8_t code;
+    char literal;      // for KISS_FORMAT_LITERAL
+    size_t offset;     // position in the output
+    size_t width;      // number of characters in the output
+};
+
+// code of a pattern character that is not a supported conversion
+static constexpr uint8_t KISS_FIXED_FORMAT_INVALID = 0xFF;
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// compile time description of the patterns
+
+// the op code of the conversion character after a '%', or KISS_FIXED_FORMAT_INVALID
+constexpr uint8_t fixed_format_conversion_code(char const conversion){
+    switch (conversion){
+        case '%':
+            return KISS_FORMAT_LITERAL;
+        case 'Y':
+            return KISS_FORMAT_YEAR;
+        case 'y':
+            return KISS_FORMAT_YEAR_IN_CENTURY;
+        case 'm':
+            return KISS_FORMAT_MONTH;
+        case 'd':
+            return KISS_FORMAT_DAY;
+        case 'H':
+            return KISS_FORMAT_HOUR;
+        case 'M':
+            return KISS_FORMAT_MINUTE;
+        case 'S':
+            return KISS_FORMAT_SECOND;
+        case 'j':
+            return KISS_FORMAT_DAY_OF_YEAR;
+        case 'a':
+            return KISS_FORMAT_WEEK_DAY_NAME_SHORT;
+        case 'b':
+            return KISS_FORMAT_MONTH_NAME_SHORT;
+        case 'u':
+            return KISS_FORMAT_WEEK_DAY;
+        default:
+            return KISS_FIXED_FORMAT_INVALID;
+    }
+}
+
+constexpr size_t fixed_format_width(uint8_t const code){
+    switch (code){
+        case KISS_FORMAT_YEAR:
+            return 4;
+        case KISS_FORMAT_DAY_OF_YEAR:
+        case KISS_FORMAT_WEEK_DAY_NAME_SHORT:
+        case KISS_FORMAT_MONTH_NAME_SHORT:
+            return 3;
+        case KISS_FORMAT_YEAR_IN_CENTURY:
+        case KISS_FORMAT_MONTH:
+        case KISS_FORMAT_DAY:
+        case KISS_FORMAT_HOUR:
+        case KISS_FORMAT_MINUTE:
+        case KISS_FORMAT_SECOND:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+// the op_index-th op of the pattern; an op with code KISS_FIXED_FORMAT_INVALID if the pattern is not valid there,
+// and an op with width 0 past the end of the pattern (its offset is then the size of the output)
+template <char const *Pattern>
+constexpr kiss_fixed_format_op fixed_format_op(size_t const op_index){
+    size_t offset {0};
+    size_t current_index {0};
+    for (size_t i=0; Pattern[i] != '\0'; i++){
+        kiss_fixed_format_op op {KISS_FORMAT_LITERAL, Pattern[i], offset, 1};
+        if (Pattern[i] == '%'){
+            i++;
+            op.code = fixed_format_conversion_code(Pattern[i]);
+            if (op.code == KISS_FIXED_FORMAT_INVALID){
+                return op;
+            }
+            op.width = fixed_format_width(op.code);
+        }
+        if (current_index == op_index){
+            return op;
+        }
+        offset += op.width;
+        current_index++;
+    }
+    return kiss_fixed_format_op {KISS_FORMAT_LITERAL, '\0', offset, 0};
+}
+
+template <char const *Pattern>
+constexpr size_t fixed_format_n_ops(){
+    size_t n_ops {0};
+    for (size_t i=0; Pattern[i] != '\0'; i++){
+        if (Pattern[i] == '%' && Pattern[i+1] != '\0'){
+            i++;
+        }
+        n_ops++;
+    }
+    return n_ops;
+}
+
+template <char const *Pattern>
+constexpr bool fixed_format_is_valid(){
+    for (size_t op_index=0; op_index<fixed_format_n_ops<Pattern>(); op_index++){
+        if (fixed_format_op<Pattern>(op_index).code == KISS_FIXED_FORMAT_INVALID){
+            return false;
+        }
+    }
+    return true;
+}
+
+// number of characters of the output, without any null byte
+template <char const *Pattern>
+constexpr size_t fixed_format_size(){
+    return fixed_format_op<Pattern>(fixed_format_n_ops<Pattern>()).offset;
+}
+
+// some op needs the week day
+template <char const *Pattern>
+constexpr bool fixed_format_needs_week_day(){
+    for (size_t op_index=0; op_index<fixed_format_n_ops<Pattern>(); op_index++){
+        uint8_t const code = fixed_format_op<Pattern>(op_index).code;
+        if (code == KISS_FORMAT_WEEK_DAY_NAME_SHORT || code == KISS_FORMAT_WEEK_DAY){
+            return true;
+        }
+    }
+    return false;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// internal helpers
+
+// index (0 based) of the 3 letters abbreviation among the first n_names names, or n_names if none
+inline uint8_t fixed_format_read_name(char const *const buffer_in, char const *const *const names, uint8_t const n_names){
+    for (uint8_t i=0; i<n_names; i++){
+        if (buffer_in[0] == names[i][0] && buffer_in[1] == names[i][1] && buffer_in[2] == names[i][2]){
+            return i;
+        }
+    }
+    return n_names;
+}
+
+// week_day: 0 is monday, ..., 6 is sunday
+template <char const *Pattern, size_t OpIndex>
+inline void fixed_format_print_op(kiss_calendar_time const *const calendar_in, uint8_t const week_day, char *const buffer_out){
+    constexpr kiss_fixed_format_op op = fixed_format_op<Pattern>(OpIndex);
+    char *const position = buffer_out + op.offset;
+
+    if constexpr (op.code == KISS_FORMAT_LITERAL){
+        position[0] = op.literal;
+    }
+    else if constexpr (op.code == KISS_FORMAT_YEAR){
+        text_write_digits(position, calendar_in->year, 4);
+    }
+    else if constexpr (op.code == KISS_FORMAT_YEAR_IN_CENTURY){
+        text_write_digits(position, calendar_in->year % 100u, 2);
+    }
+    else if constexpr (op.code == KISS_FORMAT_MONTH){
+        text_write_digits(position, calendar_in->month, 2);
+    }
+    else if constexpr (op.code == KISS_FORMAT_DAY){
+        text_write_digits(position, calendar_in->day, 2);
+    }
+    else if constexpr (op.code == KISS_FORMAT_HOUR){
+        text_write_digits(position, calendar_in->hour, 2);
+    }
+    else if constexpr (op.code == KISS_FORMAT_MINUTE){
+        text_write_digits(position, calendar_in->minute, 2);
+    }
+    else if constexpr (op.code == KISS_FORMAT_SECOND){
+        text_write_digits(position, calendar_in->second, 2);
+    }
+    else if constexpr (op.code == KISS_FORMAT_DAY_OF_YEAR){
+        uint16_t const *const cumulative_days = is_leap_year(calendar_in->year) ? cumulative_days_per_month_leap : cumulative_days_per_month_normal;
+        text_write_digits(position, static_cast<uint32_t>(cumulative_days[calendar_in->month - 1]) + calendar_in->day, 3);
+    }
+    else if constexpr (op.code == KISS_FORMAT_WEEK_DAY_NAME_SHORT){
+        position[0] = day_names[week_day][0];
+        position[1] = day_names[week_day][1];
+        position[2] = day_names[week_day][2];
+    }
+    else if constexpr (op.code == KISS_FORMAT_MONTH_NAME_SHORT){
+        position[0] = month_names[calendar_in->month - 1][0];
+        position[1] = month_names[calendar_in->month - 1][1];
+        position[2] = month_names[calendar_in->month - 1][2];
+    }
+    else if constexpr (op.code == KISS_FORMAT_WEEK_DAY){
+        position[0] = static_cast<char>('1' + week_day);
+    }
+}
+
+template <char const *Pattern, size_t... OpIndex>
+inline void fixed_format_print_ops(kiss_calendar_time const *const calendar_in, uint8_t const week_day, char *const buffer_out,
+                                   std::index_sequence<OpIndex...>){
+    (fixed_format_print_op<Pattern, OpIndex>(calendar_in, week_day, buffer_out), ...);
+}
+
+template <char const *Pattern, size_t OpIndex>
+inline bool fixed_format_parse_op(char const *const buffer_in, kiss_text_parse_state *const state){
+    constexpr kiss_fixed_format_op op = fixed_format_op<Pattern>(OpIndex);
+    char const *const position = buffer_in + op.offset;
+    uint32_t value {0};
+
+    if constexpr (op.code == KISS_FORMAT_LITERAL){
+        return position[0] == op.literal;
+    }
+    else if constexpr (op.code == KISS_FORMAT_WEEK_DAY_NAME_SHORT){
+        state->week_day = static_cast<uint8_t>(fixed_format_read_name(position, day_names, 7) + 1);
+        return state->week_day <= 7;
+    }
+    else if constexpr (op.code == KISS_FORMAT_MONTH_NAME_SHORT){
+        state->calendar.month = static_cast<uint8_t>(fixed_format_read_name(position, month_names, 12) + 1);
+        return state->calendar.month <= 12;
+    }
+    else{
+        // all the other conversions are digits; their ranges are checked at the end, by the checked conversion
+        bool const all_digits = text_read_digits(position, static_cast<uint8_t>(op.width), &value);
+        if constexpr (op.code == KISS_FORMAT_YEAR){
+            state->calendar.year = static_cast<uint16_t>(value);
+        }
+        else if constexpr (op.code == KISS_FORMAT_YEAR_IN_CENTURY){
+            // as strptime: 69 to 99 are in the 1900s, 00 to 68 in the 2000s
+            state->calendar.year = static_cast<uint16_t>(value < 69 ? 2000 + value : 1900 + value);
+        }
+        else if constexpr (op.code == KISS_FORMAT_MONTH){
+            state->calendar.month = static_cast<uint8_t>(value);
+        }
+        else if constexpr (op.code == KISS_FORMAT_DAY){
+            state->calendar.day = static_cast<uint8_t>(value);
+        }
+        else if constexpr (op.code == KISS_FORMAT_HOUR){
+            state->calendar.hour = static_cast<uint8_t>(value);
+        }
+        else if constexpr (op.code == KISS_FORMAT_MINUTE){
+            state->calendar.minute = static_cast<uint8_t>(value);
+        }
+        else if constexpr (op.code == KISS_FORMAT_SECOND){
+            state->calendar.second = static_cast<uint8_t>(value);
+        }
+        else if constexpr (op.code == KISS_FORMAT_DAY_OF_YEAR){
+            state->day_of_year = static_cast<uint16_t>(value);
+            return all_digits && value >= 1;
+        }
+        else if constexpr (op.code == KISS_FORMAT_WEEK_DAY){
+            state->week_day = static_cast<uint8_t>(value);
+            return all_digits && value >= 1 && value <= 7;
+        }
+        return all_digits;
+    }
+}
+
+template <char const *Pattern, size_t... OpIndex>
+inline bool fixed_format_parse_ops(char const *const buffer_in, kiss_text_parse_state *const state, std::index_sequence<OpIndex...>){
+    return (fixed_format_parse_op<Pattern, OpIndex>(buffer_in, state) && ...);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// functions
+
+// print a time with the pattern: exactly fixed_format_size<Pattern>() characters, no null byte
+// there is nothing to check at run time, so there is no failure; calendar_in must be valid, with a year up to 9999
+template <char const *Pattern>
+inline void fixed_format_print(kiss_calendar_time const *const calendar_in, char *const buffer_out){
+    static_assert(fixed_format_is_valid<Pattern>(), "the pattern has a conversion that is unknown or does not have a fixed width");
+
+    uint8_t week_day {0};
+    if constexpr (fixed_format_needs_week_day<Pattern>()){
+        week_day = static_cast<uint8_t>(day_of_week(calendar_in) - 1);
+    }
+    fixed_format_print_ops<Pattern>(calendar_in, week_day, buffer_out, std::make_index_sequence<fixed_format_n_ops<Pattern>()>{});
+}
+
+template <char const *Pattern>
+inline void fixed_format_print(kiss_time_t const posix_in, char *const buffer_out){
+    static_assert(fixed_format_is_valid<Pattern>(), "the pattern has a conversion that is unknown or does not have a fixed width");
+
+    kiss_calendar_time working_calendar;
+    posix_to_calendar(posix_in, &working_calendar);
+    uint8_t week_day {0};
+    if constexpr (fixed_format_needs_week_day<Pattern>()){
+        week_day = static_cast<uint8_t>(day_of_week(posix_in) - 1);
+    }
+    fixed_format_print_ops<Pattern>(&working_calendar, week_day, buffer_out, std::make_index_sequence<fixed_format_n_ops<Pattern>()>{});
+}
+
+// parse exactly fixed_format_size<Pattern>() characters with the pattern; the fields that are not in the pattern are
+// those of 1970-01-01T00:00:00, and the week day (%a, %u), if any, must be the one of the date
+// return true if success, false if the text does not match the pattern or is not a valid time (then, the output is
+// not written to)
+template <char const *Pattern>
+inline bool fixed_format_parse(char const *const buffer_in, kiss_calendar_time *const calendar_out){
+    static_assert(fixed_format_is_valid<Pattern>(), "the pattern has a conversion that is unknown or does not have a fixed width");
+
+    kiss_text_parse_state state {{EPOCH_START, 1, 1, 0, 0, 0}, 0, 0, 0, false};
+    if (!fixed_format_parse_ops<Pattern>(buffer_in, &state, std::make_index_sequence<fixed_format_n_ops<Pattern>()>{})){
+        return false;
+    }
+
+    kiss_time_t posix;
+    if (!text_parse_finish(&state, &posix)){
+        return false;
+    }
+
+    *calendar_out = state.calendar;
+    return true;
+}
+
+template <char const *Pattern>
+inline bool fixed_format_parse(char const *const buffer_in, kiss_time_t *const posix_out){
+    kiss_calendar_time working_calendar;
+    if (!fixed_format_parse<Pattern>(buffer_in, &working_calendar)){
+        return false;
+    }
+    *posix_out = calendar_to_posix(&working_calendar);
+    return true;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,478 @@
+#ifndef KISS_POSIX_TIME_FORMAT_IMPLEMENTATION
+#define KISS_POSIX_TIME_FORMAT_IMPLEMENTATION
+
+#include "kiss_posix_time_format.hpp"
+#include "kiss_posix_time_text_helpers.hpp"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// internal helpers
+
+// longest output of each op, by kiss_format_op_code; the literals count their own length
+static constexpr uint8_t format_op_max_length[] = {0, 5, 2, 2, 2, 2, 2, 2, 3, 3, 9, 3, 9, 1, 20};
+
+// lengths of day_names and month_names
+static constexpr uint8_t format_day_name_lengths[] = {6, 7, 9, 8, 6, 8, 6};
+static constexpr uint8_t format_month_name_lengths[] = {7, 8, 5, 5, 3, 4, 4, 6, 9, 7, 8, 8};
+
+// the op of a conversion character; return false if there is none
+static bool format_conversion_op(char const conversion, uint8_t *const code_out){
+    switch (conversion){
+        case 'Y':
+            *code_out = KISS_FORMAT_YEAR;
+            return true;
+        case 'y':
+            *code_out = KISS_FORMAT_YEAR_IN_CENTURY;
+            return true;
+        case 'm':
+            *code_out = KISS_FORMAT_MONTH;
+            return true;
+        case 'd':
+            *code_out = KISS_FORMAT_DAY;
+            return true;
+        case 'H':
+            *code_out = KISS_FORMAT_HOUR;
+            return true;
+        case 'M':
+            *code_out = KISS_FORMAT_MINUTE;
+            return true;
+        case 'S':
+            *code_out = KISS_FORMAT_SECOND;
+            return true;
+        case 'j':
+            *code_out = KISS_FORMAT_DAY_OF_YEAR;
+            return true;
+        case 'a':
+            *code_out = KISS_FORMAT_WEEK_DAY_NAME_SHORT;
+            return true;
+        case 'A':
+            *code_out = KISS_FORMAT_WEEK_DAY_NAME;
+            return true;
+        case 'b':
+            *code_out = KISS_FORMAT_MONTH_NAME_SHORT;
+            return true;
+        case 'B':
+            *code_out = KISS_FORMAT_MONTH_NAME;
+            return true;
+        case 'u':
+            *code_out = KISS_FORMAT_WEEK_DAY;
+            return true;
+        case 's':
+            *code_out = KISS_FORMAT_POSIX;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// append a literal character to the program, merged with the previous literal op if there is one
+static bool format_append_literal(kiss_format_program *const program, char const character){
+    if (program->n_literals == KISS_FORMAT_MAX_LITERALS){
+        return false;
+    }
+
+    kiss_format_op *const last_op = (program->n_ops > 0) ? &program->ops[program->n_ops - 1] : nullptr;
+    if (last_op == nullptr || last_op->code != KISS_FORMAT_LITERAL){
+        if (program->n_ops == KISS_FORMAT_MAX_OPS){
+            return false;
+        }
+        program->ops[program->n_ops] = kiss_format_op {KISS_FORMAT_LITERAL, program->n_literals, 0};
+        program->n_ops++;
+    }
+
+    program->literals[program->n_literals] = character;
+    program->n_literals++;
+    program->ops[program->n_ops - 1].literal_length++;
+    program->max_length++;
+    return true;
+}
+
+static bool format_append_op(kiss_format_program *const program, uint8_t const code){
+    if (program->n_ops == KISS_FORMAT_MAX_OPS){
+        return false;
+    }
+
+    program->ops[program->n_ops] = kiss_format_op {code, 0, 0};
+    program->n_ops++;
+    program->max_length = static_cast<uint16_t>(program->max_length + format_op_max_length[code]);
+    program->needs_posix = program->needs_posix || code == KISS_FORMAT_WEEK_DAY_NAME_SHORT || code == KISS_FORMAT_WEEK_DAY_NAME
+                           || code == KISS_FORMAT_WEEK_DAY || code == KISS_FORMAT_POSIX;
+    return true;
+}
+
+static size_t format_copy(char *const buffer_out, char const *const text, uint8_t const length){
+    for (uint8_t i=0; i<length; i++){
+        buffer_out[i] = text[i];
+    }
+    return length;
+}
+
+// run the program; posix_in is only used if program->needs_posix
+// return the number of characters written, no null byte
+static size_t format_run(kiss_format_program const *const program, kiss_calendar_time const *const calendar_in,
+                         kiss_time_t const posix_in, char *const buffer_out){
+    // 0 is monday, ..., 6 is sunday
+    uint8_t const week_day = program->needs_posix ? static_cast<uint8_t>(day_of_week(posix_in) - 1) : 0;
+    size_t length {0};
+
+    for (size_t i=0; i<program->n_ops; i++){
+        kiss_format_op const op = program->ops[i];
+        char *const position = &buffer_out[length];
+
+        switch (op.code){
+            case KISS_FORMAT_LITERAL:
+                length += format_copy(position, &program->literals[op.literal_offset], op.literal_length);
+                break;
+            case KISS_FORMAT_YEAR: {
+                uint8_t const n_digits = (calendar_in->year < 10000) ? 4 : 5;
+                text_write_digits(position, calendar_in->year, n_digits);
+                length += n_digits;
+                break;
+            }
+            case KISS_FORMAT_YEAR_IN_CENTURY:
+                text_write_digits(position, calendar_in->year % 100u, 2);
+                length += 2;
+                break;
+            case KISS_FORMAT_MONTH:
+                text_write_digits(position, calendar_in->month, 2);
+                length += 2;
+                break;
+            case KISS_FORMAT_DAY:
+                text_write_digits(position, calendar_in->day, 2);
+                length += 2;
+                break;
+            case KISS_FORMAT_HOUR:
+                text_write_digits(position, calendar_in->hour, 2);
+                length += 2;
+                break;
+            case KISS_FORMAT_MINUTE:
+                text_write_digits(position, calendar_in->minute, 2);
+                length += 2;
+                break;
+            case KISS_FORMAT_SECOND:
+                text_write_digits(position, calendar_in->second, 2);
+                length += 2;
+                break;
+            case KISS_FORMAT_DAY_OF_YEAR: {
+                uint16_t const *const cumulative_days = is_leap_year(calendar_in->year) ? cumulative_days_per_month_leap : cumulative_days_per_month_normal;
+                text_write_digits(position, static_cast<uint32_t>(cumulative_days[calendar_in->month - 1]) + calendar_in->day, 3);
+                length += 3;
+                break;
+            }
+            case KISS_FORMAT_WEEK_DAY_NAME_SHORT:
+                length += format_copy(position, day_names[week_day], 3);
+                break;
+            case KISS_FORMAT_WEEK_DAY_NAME:
+                length += format_copy(position, day_names[week_day], format_day_name_lengths[week_day]);
+                break;
+            case KISS_FORMAT_MONTH_NAME_SHORT:
+                length += format_copy(position, month_names[calendar_in->month - 1], 3);
+                break;
+            case KISS_FORMAT_MONTH_NAME:
+                length += format_copy(position, month_names[calendar_in->month - 1], format_month_name_lengths[calendar_in->month - 1]);
+                break;
+            case KISS_FORMAT_WEEK_DAY:
+                position[0] = static_cast<char>('1' + week_day);
+                length += 1;
+                break;
+            case KISS_FORMAT_POSIX: {
+                // the digits backwards to a scratch buffer, then in order to the output
+                char digits[20];
+                uint8_t n_digits {0};
+                kiss_time_t value {posix_in};
+                do{
+                    digits[n_digits] = static_cast<char>('0' + value % 10);
+                    n_digits++;
+                    value /= 10;
+                } while (value != 0);
+                for (uint8_t j=0; j<n_digits; j++){
+                    position[j] = digits[n_digits - 1 - j];
+                }
+                length += n_digits;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return length;
+}
+
+static size_t format_print_checked(kiss_format_program const *const program, kiss_calendar_time const *const calendar_in,
+                                   kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size){
+    // check that we have a buffer large enough for any time; if not, return 0 and fill with null bytes
+    if (buffer_size < static_cast<size_t>(program->max_length) + 1){
+        for (size_t i=0; i<buffer_size; i++){
+            buffer_out[i] = '\0';
+        }
+        return 0;
+    }
+
+    size_t const length = format_run(program, calendar_in, posix_in, buffer_out);
+    buffer_out[length] = '\0';
+    return length;
+}
+
+// number of digits that each op reads when parsing, by kiss_format_op_code; 0 for the ops that are not a fixed number
+// of digits
+static constexpr uint8_t format_op_parse_digits[] = {0, 4, 2, 2, 2, 2, 2, 2, 3, 0, 0, 0, 0, 1, 0};
+
+static bool format_matches(char const *const text_in, char const *const expected, size_t const length){
+    for (size_t i=0; i<length; i++){
+        if (text_in[i] != expected[i]){
+            return false;
+        }
+    }
+    return true;
+}
+
+// match one of the names at the start of the text, on their 3 first characters if short_names, else in full
+// return the number of characters read, or 0 if no name matches; index_out is the index of the name
+static size_t format_read_name(char const *const text_in, size_t const length_in, char const *const *const names, uint8_t const *const name_lengths,
+                               uint8_t const n_names, bool const short_names, uint8_t *const index_out){
+    for (uint8_t i=0; i<n_names; i++){
+        size_t const length = short_names ? 3 : name_lengths[i];
+        if (length <= length_in && format_matches(text_in, names[i], length)){
+            *index_out = i;
+            return length;
+        }
+    }
+    return 0;
+}
+
+// read the decimal digits of a posix time, as many as there are, at least one and without overflow
+// return the number of characters read, or 0 if there is no valid number
+static size_t format_read_posix(char const *const text_in, size_t const length_in, kiss_time_t *const posix_out){
+    kiss_time_t posix {0};
+    size_t n_digits {0};
+    while (n_digits < length_in){
+        uint8_t const digit = static_cast<uint8_t>(text_in[n_digits] - '0');
+        if (digit > 9){
+            break;
+        }
+        if (posix > (UINT64_MAX - digit) / 10){
+            return 0;
+        }
+        posix = posix * 10 + digit;
+        n_digits++;
+    }
+    *posix_out = posix;
+    return n_digits;
+}
+
+// parse exactly length_in characters; posix_out is only written to if success
+static bool format_parse_text(kiss_format_program const *const program, char const *const text_in, size_t const length_in,
+                              kiss_time_t *const posix_out){
+    kiss_text_parse_state state {{EPOCH_START, 1, 1, 0, 0, 0}, 0, 0, 0, false};
+    size_t position {0};
+
+    // the ops only read the text and check its syntax; the ranges are all checked at the end
+    for (size_t i=0; i<program->n_ops; i++){
+        kiss_format_op const op = program->ops[i];
+        char const *const cursor = text_in + position;
+        size_t const remaining = length_in - position;
+
+        uint32_t value {0};
+        uint8_t const n_digits = format_op_parse_digits[op.code];
+        if (n_digits != 0){
+            if (remaining < n_digits || !text_read_digits(cursor, n_digits, &value)){
+                return false;
+            }
+            position += n_digits;
+        }
+
+        uint8_t index {0};
+        size_t length {0};
+        switch (op.code){
+            case KISS_FORMAT_LITERAL:
+                if (remaining < op.literal_length || !format_matches(cursor, &program->literals[op.literal_offset], op.literal_length)){
+                    return false;
+                }
+                position += op.literal_length;
+                break;
+            case KISS_FORMAT_YEAR:
+                state.calendar.year = static_cast<uint16_t>(value);
+                break;
+            case KISS_FORMAT_YEAR_IN_CENTURY:
+                // as strptime: 69 to 99 are in the 1900s, 00 to 68 in the 2000s
+                state.calendar.year = static_cast<uint16_t>(value < 69 ? 2000 + value : 1900 + value);
+                break;
+            case KISS_FORMAT_MONTH:
+                state.calendar.month = static_cast<uint8_t>(value);
+                break;
+            case KISS_FORMAT_DAY:
+                state.calendar.day = static_cast<uint8_t>(value);
+                break;
+            case KISS_FORMAT_HOUR:
+                state.calendar.hour = static_cast<uint8_t>(value);
+                break;
+            case KISS_FORMAT_MINUTE:
+                state.calendar.minute = static_cast<uint8_t>(value);
+                break;
+            case KISS_FORMAT_SECOND:
+                state.calendar.second = static_cast<uint8_t>(value);
+                break;
+            case KISS_FORMAT_DAY_OF_YEAR:
+                if (value == 0){
+                    return false;
+                }
+                state.day_of_year = static_cast<uint16_t>(value);
+                break;
+            case KISS_FORMAT_WEEK_DAY_NAME_SHORT:
+            case KISS_FORMAT_WEEK_DAY_NAME:
+                length = format_read_name(cursor, remaining, day_names, format_day_name_lengths, 7, op.code == KISS_FORMAT_WEEK_DAY_NAME_SHORT, &index);
+                if (length == 0){
+                    return false;
+                }
+                state.week_day = static_cast<uint8_t>(index + 1);
+                position += length;
+                break;
+            case KISS_FORMAT_MONTH_NAME_SHORT:
+            case KISS_FORMAT_MONTH_NAME:
+                length = format_read_name(cursor, remaining, month_names, format_month_name_lengths, 12, op.code == KISS_FORMAT_MONTH_NAME_SHORT, &index);
+                if (length == 0){
+                    return false;
+                }
+                state.calendar.month = static_cast<uint8_t>(index + 1);
+                position += length;
+                break;
+            case KISS_FORMAT_WEEK_DAY:
+                if (value == 0 || value > 7){
+                    return false;
+                }
+                state.week_day = static_cast<uint8_t>(value);
+                break;
+            case KISS_FORMAT_POSIX:
+                length = format_read_posix(cursor, remaining, &state.posix);
+                if (length == 0){
+                    return false;
+                }
+                state.has_posix = true;
+                position += length;
+                break;
+            default:
+                return false;
+        }
+    }
+
+    if (position != length_in){
+        return false;
+    }
+
+    return text_parse_finish(&state, posix_out);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// functions
+
+KISS_POSIX_TIME_INLINE bool format_compile(char const *const pattern, kiss_format_program *const program_out){
+    program_out->n_ops = 0;
+    program_out->n_literals = 0;
+    program_out->max_length = 0;
+    program_out->needs_posix = false;
+
+    char const *cursor {pattern};
+    while (*cursor != '\0'){
+        if (*cursor != '%'){
+            if (!format_append_literal(program_out, *cursor)){
+                return false;
+            }
+            cursor++;
+            continue;
+        }
+
+        // a conversion; a '%' at the very end is not one, and is never read past
+        cursor++;
+        uint8_t code {0};
+        if (*cursor == '%'){
+            if (!format_append_literal(program_out, '%')){
+                return false;
+            }
+        }
+        else if (!format_conversion_op(*cursor, &code) || !format_append_op(program_out, code)){
+            return false;
+        }
+        cursor++;
+    }
+
+    return true;
+}
+
+KISS_POSIX_TIME_INLINE size_t format_print(kiss_format_program const *const program, kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size){
+    kiss_calendar_time working_calendar;
+    posix_to_calendar(posix_in, &working_calendar);
+    return format_print_checked(program, &working_calendar, posix_in, buffer_out, buffer_size);
+}
+
+KISS_POSIX_TIME_INLINE size_t format_print(kiss_format_program const *const program, kiss_calendar_time const *const calendar_in, char *const buffer_out, size_t const buffer_size){
+    kiss_time_t const posix = program->needs_posix ? calendar_to_posix(calendar_in) : 0;
+    return format_print_checked(program, calendar_in, posix, buffer_out, buffer_size);
+}
+
+KISS_POSIX_TIME_INLINE size_t format_print_arena(kiss_format_program const *const program, kiss_time_t const *const posix_in, size_t const n_entries,
+                                                 kiss_text_arena *const arena, kiss_text_view *const views_out){
+    kiss_calendar_time working_calendar;
+    for (size_t i=0; i<n_entries; i++){
+        if (arena->capacity - arena->size < program->max_length){
+            return i;
+        }
+        posix_to_calendar(posix_in[i], &working_calendar);
+        size_t const length = format_run(program, &working_calendar, posix_in[i], arena->buffer + arena->size);
+        views_out[i] = kiss_text_view {arena->size, length};
+        arena->size += length;
+    }
+    return n_entries;
+}
+
+KISS_POSIX_TIME_INLINE size_t format_print_arena(kiss_format_program const *const program, kiss_calendar_time const *const calendar_in, size_t const n_entries,
+                                                 kiss_text_arena *const arena, kiss_text_view *const views_out){
+    for (size_t i=0; i<n_entries; i++){
+        if (arena->capacity - arena->size < program->max_length){
+            return i;
+        }
+        kiss_time_t const posix = program->needs_posix ? calendar_to_posix(&calendar_in[i]) : 0;
+        size_t const length = format_run(program, &calendar_in[i], posix, arena->buffer + arena->size);
+        views_out[i] = kiss_text_view {arena->size, length};
+        arena->size += length;
+    }
+    return n_entries;
+}
+
+KISS_POSIX_TIME_INLINE bool format_parse(kiss_format_program const *const program, char const *const text_in, size_t const length_in,
+                                         kiss_time_t *const posix_out){
+    return format_parse_text(program, text_in, length_in, posix_out);
+}
+
+KISS_POSIX_TIME_INLINE size_t format_parse_lines(kiss_format_program const *const program, char const *const buffer_in, size_t const buffer_size,
+                                                 kiss_time_t *const posix_out, uint8_t *const valid_mask_out, size_t const max_lines,
+                                                 size_t *const n_bytes_out){
+    size_t position {0};
+    size_t n_lines {0};
+
+    while (position < buffer_size && n_lines < max_lines){
+        // the end of the line, and the start of the next one
+        size_t end {position};
+        while (end < buffer_size && buffer_in[end] != '\n'){
+            end++;
+        }
+        size_t const next = (end < buffer_size) ? end + 1 : end;
+        if (end > position && buffer_in[end - 1] == '\r'){
+            end--;
+        }
+
+        kiss_time_t posix {0};
+        bool const valid = format_parse_text(program, buffer_in + position, end - position, &posix);
+        posix_out[n_lines] = posix;
+        text_set_valid(valid_mask_out, n_lines, valid);
+
+        n_lines++;
+        position = next;
+    }
+
+    *n_bytes_out = position;
+    return n_lines;
+}
+
+#endif
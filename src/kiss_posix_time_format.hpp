@@ -0,0 +1,133 @@
+#ifndef KISS_POSIX_TIME_FORMAT
+#define KISS_POSIX_TIME_FORMAT
+
+#include "kiss_posix_time_utils.hpp"
+#include "kiss_posix_time_extras.hpp"
+
+/*
+
+Formatting and parsing of times with strftime-like patterns, for example "%d/%m/%Y %H:%M", or the RFC 1123 dates of the HTTP
+Date header, "%a, %d %b %Y %H:%M:%S GMT".
+
+The pattern is compiled once (format_compile) into a small program: a list of operations, with the literal text
+stored next to it. Printing then runs the program, writing the digits directly and copying the names, without
+parsing the pattern again and without any locale (the names are the English ones of kiss_posix_time_extras).
+No dynamic allocation: the program is a small struct owned by the caller.
+
+The supported conversions are:
+- %Y: year, 4 digits (5 after year 9999)
+- %y: year within the century, 2 digits
+- %m: month, 01 to 12
+- %d: day of the month, 01 to 31
+- %H: hour, 00 to 23
+- %M: minute, 00 to 59
+- %S: second, 00 to 59
+- %j: day of the year, 001 to 366
+- %a: abbreviated week day name, Mon to Sun
+- %A: full week day name, Monday to Sunday
+- %b: abbreviated month name, Jan to Dec
+- %B: full month name, January to December
+- %u: week day, 1 (monday) to 7 (sunday)
+- %s: posix time, in seconds
+- %%: a '%' character
+
+The same compiled patterns parse text back to posix times (format_parse), for example "%Y%m%d%H%M%S",
+"%d/%m/%Y %H:%M:%S", "%Y-%j" or "%s". The text is only read once: the fields are collected while checking the syntax,
+and then checked and converted in a single step by calendar_to_posix_checked. When parsing:
+- %Y is exactly 4 digits, and all the other numbers except %s have exactly the widths above
+- %y is in 1969 to 2068, as with strptime
+- %j sets the month and the day
+- %a, %A, %u must be the week day of the date
+- %s is 1 or more digits, and gives the time directly (the other conversions are then only checked for their syntax)
+- the fields that are not in the pattern are those of 1970-01-01T00:00:00
+
+*/
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// data structures
+
+enum kiss_format_op_code : uint8_t
+{
+    KISS_FORMAT_LITERAL = 0,
+    KISS_FORMAT_YEAR,
+    KISS_FORMAT_YEAR_IN_CENTURY,
+    KISS_FORMAT_MONTH,
+    KISS_FORMAT_DAY,
+    KISS_FORMAT_HOUR,
+    KISS_FORMAT_MINUTE,
+    KISS_FORMAT_SECOND,
+    KISS_FORMAT_DAY_OF_YEAR,
+    KISS_FORMAT_WEEK_DAY_NAME_SHORT,
+    KISS_FORMAT_WEEK_DAY_NAME,
+    KISS_FORMAT_MONTH_NAME_SHORT,
+    KISS_FORMAT_MONTH_NAME,
+    KISS_FORMAT_WEEK_DAY,
+    KISS_FORMAT_POSIX
+};
+
+// limits of a compiled pattern
+static constexpr size_t KISS_FORMAT_MAX_OPS      = 32;
+static constexpr size_t KISS_FORMAT_MAX_LITERALS = 64;
+
+struct kiss_format_op
+{
+    uint8_t code;              // one of the kiss_format_op_code
+    uint8_t literal_offset;    // for KISS_FORMAT_LITERAL: the text in kiss_format_program::literals
+    uint8_t literal_length;
+};
+
+// a compiled pattern; fill with format_compile, and do not modify the fields by hand
+struct kiss_format_program
+{
+    kiss_format_op ops[KISS_FORMAT_MAX_OPS];
+    char literals[KISS_FORMAT_MAX_LITERALS];
+    uint8_t n_ops;
+    uint8_t n_literals;
+    uint16_t max_length;       // longest output, without the null byte
+    bool needs_posix;          // some op uses the posix time (%a, %A, %u, %s)
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// functions
+
+// compile a null terminated pattern
+// return true if success, false if the pattern has an unknown conversion, ends with a lone '%', or does not fit in
+// the limits above (then, program_out is unspecified)
+bool format_compile(char const *const pattern, kiss_format_program *const program_out);
+
+// print a time with a compiled pattern to buffer, null terminated
+// the buffer size must be at least program->max_length + 1, whatever the time
+// return the number of characters written (not counting the null byte), or 0 if the buffer is too small (then, the
+// buffer is filled with null bytes)
+size_t format_print(kiss_format_program const *const program, kiss_time_t const posix_in, char *const buffer_out, size_t const buffer_size);
+size_t format_print(kiss_format_program const *const program, kiss_calendar_time const *const calendar_in, char *const buffer_out, size_t const buffer_size);
+
+// print n_entries times to an arena (see kiss_posix_time_extras), with their views; the strings are not null terminated
+// return the number of entries printed, that is less than n_entries only if the arena is full
+size_t format_print_arena(kiss_format_program const *const program, kiss_time_t const *const posix_in, size_t const n_entries,
+                          kiss_text_arena *const arena, kiss_text_view *const views_out);
+size_t format_print_arena(kiss_format_program const *const program, kiss_calendar_time const *const calendar_in, size_t const n_entries,
+                          kiss_text_arena *const arena, kiss_text_view *const views_out);
+
+// parse exactly length_in characters of text (no null byte needed) with a compiled pattern
+// return true if success, false if the text does not match the pattern or is not a valid time (then, posix_out is not
+// written to)
+bool format_parse(kiss_format_program const *const program, char const *const text_in, size_t const length_in,
+                  kiss_time_t *const posix_out);
+
+// parse the lines of a buffer, separated by '\n' (a '\r' before it is ignored, and the last line does not need one),
+// with one time per line, up to max_lines lines; bit i % 8 of valid_mask_out[i / 8] is set if line i is valid, and
+// posix_out[i] is 0 for the lines that are not
+// return the number of lines read; n_bytes_out is the number of bytes of the buffer they took, so that the rest can
+// be parsed in a next call if there were more than max_lines lines
+size_t format_parse_lines(kiss_format_program const *const program, char const *const buffer_in, size_t const buffer_size,
+                          kiss_time_t *const posix_out, uint8_t *const valid_mask_out, size_t const max_lines,
+                          size_t *const n_bytes_out);
+
+#ifdef KISS_POSIX_TIME_HEADER_ONLY
+  #include "kiss_posix_time_format.cpp"
+#endif
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef KISS_POSIX_TIME_INSTRUMENTATION_IMPLEMENTATION
+#define KISS_POSIX_TIME_INSTRUMENTATION_IMPLEMENTATION
+
+#include "kiss_posix_time_instrumentation.hpp"
+#include "kiss_posix_time_shared_state.hpp"
+
+// nothing at all in this file unless the instrumentation is on
+#ifdef KISS_POSIX_TIME_INSTRUMENTATION
+
+#include <atomic>
+#include <chrono>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// internal helpers
+
+// the counters of one thread; only the owning thread writes to them, with plain load and store (no read-modify-write),
+// and they are atomic only so that instrumentation_snapshot can read them at the same time
+struct kiss_instrumentation_block
+{
+    std::atomic<uint64_t> counters[KISS_N_INSTRUMENTATION_COUNTERS];
+    std::atomic<uint64_t> histograms[KISS_N_INSTRUMENTATION_TIMERS][KISS_N_INSTRUMENTATION_BUCKETS];
+    std::atomic<bool> in_use;
+    kiss_instrumentation_block *next;    // set before the block is published, never changed after
+};
+
+// head of the list of all blocks; blocks are only ever added at the head, and never removed.
+// the function local statics are in external functions, so that there is a single list also in header-only mode
+KISS_POSIX_TIME_INLINE std::atomic<kiss_instrumentation_block *> *kiss_instrumentation_blocks(){
+    static std::atomic<kiss_instrumentation_block *> head {nullptr};
+    return &head;
+}
+
+// take a block that an exited thread left, or add a new one to the list
+KISS_POSIX_TIME_INLINE kiss_instrumentation_block *kiss_instrumentation_acquire_block(){
+    std::atomic<kiss_instrumentation_block *> *const head = kiss_instrumentation_blocks();
+
+    for (kiss_instrumentation_block *block = head->load(std::memory_order_acquire); block != nullptr; block = block->next){
+        bool expected {false};
+        if (block->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)){
+            return block;
+        }
+    }
+
+    kiss_instrumentation_block *const block = new kiss_instrumentation_block();
+    for (size_t i=0; i<KISS_N_INSTRUMENTATION_COUNTERS; i++){
+        block->counters[i].store(0, std::memory_order_relaxed);
+    }
+    for (size_t timer=0; timer<KISS_N_INSTRUMENTATION_TIMERS; timer++){
+        for (size_t bucket=0; bucket<KISS_N_INSTRUMENTATION_BUCKETS; bucket++){
+            block->histograms[timer][bucket].store(0, std::memory_order_relaxed);
+        }
+    }
+    block->in_use.store(true, std::memory_order_relaxed);
+
+    kiss_instrumentation_block *old_head = head->load(std::memory_order_relaxed);
+    do{
+        block->next = old_head;
+    } while (!head->compare_exchange_weak(old_head, block, std::memory_order_release, std::memory_order_relaxed));
+
+    return block;
+}
+
+// gives the block back when the thread exits
+struct kiss_instrumentation_owner
+{
+    kiss_instrumentation_block *block;
+
+    ~kiss_instrumentation_owner(){
+        if (block != nullptr){
+            block->in_use.store(false, std::memory_order_release);
+        }
+    }
+};
+
+KISS_POSIX_TIME_INLINE kiss_instrumentation_block *kiss_instrumentation_thread_block(){
+    thread_local kiss_instrumentation_owner owner {nullptr};
+    if (owner.block == nullptr){
+        owner.block = kiss_instrumentation_acquire_block();
+    }
+    return owner.block;
+}
+
+static void instrumentation_add(std::atomic<uint64_t> *const value, uint64_t const n){
+    value->store(value->load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+static size_t instrumentation_bucket(uint64_t const ticks){
+    size_t bucket {0};
+    #if defined(__GNUC__)
+        bucket = (ticks == 0) ? 0 : static_cast<size_t>(63 - __builtin_clzll(ticks));
+    #else
+        while (bucket < 63 && (ticks >> (bucket + 1)) != 0){
+            bucket++;
+        }
+    #endif
+    return (bucket < KISS_N_INSTRUMENTATION_BUCKETS) ? bucket : KISS_N_INSTRUMENTATION_BUCKETS - 1;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// functions
+
+KISS_POSIX_TIME_INLINE void instrumentation_count(uint8_t const counter, uint64_t const n){
+    instrumentation_add(&kiss_instrumentation_thread_block()->counters[counter], n);
+}
+
+KISS_POSIX_TIME_INLINE uint64_t instrumentation_ticks(){
+    #if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        return __rdtsc();
+    #else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    #endif
+}
+
+KISS_POSIX_TIME_INLINE void instrumentation_record(uint8_t const timer, uint64_t const ticks){
+    instrumentation_add(&kiss_instrumentation_thread_block()->histograms[timer][instrumentation_bucket(ticks)], 1);
+}
+
+KISS_POSIX_TIME_INLINE void instrumentation_snapshot(kiss_instrumentation_snapshot *const snapshot_out){
+    *snapshot_out = kiss_instrumentation_snapshot {};
+
+    for (kiss_instrumentation_block *block = kiss_instrumentation_blocks()->load(std::memory_order_acquire); block != nullptr; block = block->next){
+        for (size_t i=0; i<KISS_N_INSTRUMENTATION_COUNTERS; i++){
+            snapshot_out->counters[i] += block->counters[i].load(std::memory_order_relaxed);
+        }
+        for (size_t timer=0; timer<KISS_N_INSTRUMENTATION_TIMERS; timer++){
+            for (size_t bucket=0; bucket<KISS_N_INSTRUMENTATION_BUCKETS; bucket++){
+                snapshot_out->histograms[timer][bucket] += block->histograms[timer][bucket].load(std::memory_order_relaxed);
+            }
+        }
+        snapshot_out->n_blocks++;
+    }
+}
+
+KISS_POSIX_TIME_INLINE char const *instrumentation_counter_name(uint8_t const counter){
+    static char const *const names[KISS_N_INSTRUMENTATION_COUNTERS] = {
+        "calendar_to_posix", "posix_to_calendar", "calendar_is_valid", "calendar_to_posix_checked",
+        "posix_to_wide_calendar", "wide_calendar_to_posix", "batch_calls", "batch_entries", "print_iso",
+        "year_loop_iterations", "clock_hits", "clock_misses"
+    };
+    return (counter < KISS_N_INSTRUMENTATION_COUNTERS) ? names[counter] : "unknown";
+}
+
+KISS_POSIX_TIME_INLINE char const *instrumentation_timer_name(uint8_t const timer){
+    static char const *const names[KISS_N_INSTRUMENTATION_TIMERS] = {
+        "calendar_to_posix", "posix_to_calendar", "print_iso"
+    };
+    return (timer < KISS_N_INSTRUMENTATION_TIMERS) ? names[timer] : "unknown";
+}
+
+#endif
+
+#endif
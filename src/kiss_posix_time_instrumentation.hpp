@@ -0,0 +1,123 @@
+#ifndef KISS_POSIX_TIME_INSTRUMENTATION_HEADER
+#define KISS_POSIX_TIME_INSTRUMENTATION_HEADER
+
+#include "kiss_posix_time_config.hpp"
+
+/*
+
+Opt-in instrumentation of the conversions: how often the functions are called, how many iterations the year loop of
+posix_to_calendar takes, and histograms of the time spent in the main conversions.
+
+This is off by default, and then compiles out completely: the KISS_INSTRUMENT_* macros used in the library expand to
+nothing, and none of the functions under exist. To turn it on, define KISS_POSIX_TIME_INSTRUMENTATION for the whole
+build (for example with the KISS_POSIX_TIME_INSTRUMENTATION CMake option). This needs C++11 threads and atomics, so
+this is not for Arduino.
+
+Each thread counts into its own block of counters, so the conversions never write to a shared cache line; the
+blocks are kept in a lock-free list, and instrumentation_snapshot sums them. When a thread exits, its block is kept
+(with its counts) and reused by the next new thread, so that nothing is lost and the number of blocks stays bounded
+by the largest number of threads alive at the same time.
+
+The times are in ticks: cycles from the time stamp counter on x86 (KISS_INSTRUMENTATION_TICKS_ARE_CYCLES is true),
+nanoseconds from std::chrono::steady_clock otherwise. The histograms have power of 2 buckets: bucket i counts the
+calls that took from 2^i to 2^(i+1) - 1 ticks (bucket 0 also counts 0 ticks, the last bucket counts everything
+longer).
+
+*/
+
+#ifdef KISS_POSIX_TIME_INSTRUMENTATION
+
+#ifdef ARDUINO
+  #error "KISS_POSIX_TIME_INSTRUMENTATION needs C++11 threads and atomics, and is not available on Arduino"
+#endif
+
+#include <cstdint>
+#include <stddef.h>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// data structures
+
+enum kiss_instrumentation_counter : uint8_t
+{
+    KISS_COUNT_CALENDAR_TO_POSIX = 0,
+    KISS_COUNT_POSIX_TO_CALENDAR,
+    KISS_COUNT_CALENDAR_IS_VALID,
+    KISS_COUNT_CALENDAR_TO_POSIX_CHECKED,
+    KISS_COUNT_POSIX_TO_WIDE_CALENDAR,
+    KISS_COUNT_WIDE_CALENDAR_TO_POSIX,
+    KISS_COUNT_BATCH_CALLS,                 // calls to any of the *_batch conversions of kiss_posix_time_utils
+    KISS_COUNT_BATCH_ENTRIES,               // total number of entries in these calls
+    KISS_COUNT_PRINT_ISO,
+    KISS_COUNT_YEAR_LOOP_ITERATIONS,        // iterations of the year loop of posix_to_calendar_jr
+    KISS_COUNT_CLOCK_HITS,                  // clock_now calls served from the cache
+    KISS_COUNT_CLOCK_MISSES,                // clock_now calls that decoded the time
+    KISS_N_INSTRUMENTATION_COUNTERS
+};
+
+enum kiss_instrumentation_timer : uint8_t
+{
+    KISS_TIMER_CALENDAR_TO_POSIX = 0,
+    KISS_TIMER_POSIX_TO_CALENDAR,
+    KISS_TIMER_PRINT_ISO,
+    KISS_N_INSTRUMENTATION_TIMERS
+};
+
+static constexpr size_t KISS_N_INSTRUMENTATION_BUCKETS = 32;
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+  static constexpr bool KISS_INSTRUMENTATION_TICKS_ARE_CYCLES = true;
+#else
+  static constexpr bool KISS_INSTRUMENTATION_TICKS_ARE_CYCLES = false;
+#endif
+
+// the sums over all threads, at the time of the snapshot
+struct kiss_instrumentation_snapshot
+{
+    uint64_t counters[KISS_N_INSTRUMENTATION_COUNTERS];
+    uint64_t histograms[KISS_N_INSTRUMENTATION_TIMERS][KISS_N_INSTRUMENTATION_BUCKETS];
+    size_t n_blocks;     // number of per thread blocks, i.e. the largest number of instrumented threads alive at the same time
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// functions
+
+// add n to a counter of the current thread
+void instrumentation_count(uint8_t const counter, uint64_t const n);
+
+// current value of the tick counter
+uint64_t instrumentation_ticks();
+
+// add a call that took ticks ticks to a histogram of the current thread
+void instrumentation_record(uint8_t const timer, uint64_t const ticks);
+
+// sum the counters and histograms of all threads; this can be called at any time, from any thread, while other
+// threads keep counting: each value is read atomically, but the snapshot as a whole is not taken at a single instant
+void instrumentation_snapshot(kiss_instrumentation_snapshot *const snapshot_out);
+
+// names, for reports; "unknown" if out of range
+char const *instrumentation_counter_name(uint8_t const counter);
+char const *instrumentation_timer_name(uint8_t const timer);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// macros used in the library
+
+#define KISS_INSTRUMENT_COUNT(counter, n) instrumentation_count(counter, n)
+#define KISS_INSTRUMENT_TIMER_START(name) uint64_t const name = instrumentation_ticks()
+#define KISS_INSTRUMENT_TIMER_STOP(timer, name) instrumentation_record(timer, instrumentation_ticks() - name)
+
+#ifdef KISS_POSIX_TIME_HEADER_ONLY
+  #include "kiss_posix_time_instrumentation.cpp"
+#endif
+
+#else
+
+#define KISS_INSTRUMENT_COUNT(counter, n)
+#define KISS_INSTRUMENT_TIMER_START(name)
+#define KISS_INSTRUMENT_TIMER_STOP(timer, name)
+
+#endif
+
+#endif
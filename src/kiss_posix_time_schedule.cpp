@@ -0,0 +1,456 @@
+#ifndef KISS_POSIX_TIME_SCHEDULE_IMPLEMENTATION
+#define KISS_POSIX_TIME_SCHEDULE_IMPLEMENTATION
+
+#include "kiss_posix_time_schedule.hpp"
+#include "kiss_posix_time_extras.hpp"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// internal helpers
+
+static uint8_t schedule_days_in_month(uint16_t const year, uint8_t const month){
+    return is_leap_year(year) ? days_per_month_leap[month-1] : days_per_month_normal[month-1];
+}
+
+// move the monthly state of the iterator to the 1st of the next month
+// this is only additions and comparisons, no need to go through the calendar conversions again
+static void schedule_move_to_next_month(kiss_schedule_iterator *const iterator){
+    uint8_t const month_length = schedule_days_in_month(iterator->year, iterator->month);
+
+    iterator->month_start += month_length * SECS_PER_DAY;
+
+    // month_length is 28 to 31, i.e. 4 full weeks plus 0 to 3 days
+    iterator->month_first_week_day = static_cast<uint8_t>(iterator->month_first_week_day + month_length - 28);
+    if (iterator->month_first_week_day > 7){
+        iterator->month_first_week_day = static_cast<uint8_t>(iterator->month_first_week_day - 7);
+    }
+
+    iterator->month = static_cast<uint8_t>(iterator->month + 1);
+    if (iterator->month > 12){
+        iterator->month = 1;
+        iterator->year = static_cast<uint16_t>(iterator->year + 1);
+    }
+}
+
+// which day of the current month is the occurrence? 0 if there is no occurrence in the current month
+static uint8_t schedule_day_in_current_month(kiss_schedule_iterator const *const iterator){
+    uint8_t const month_length = schedule_days_in_month(iterator->year, iterator->month);
+    uint8_t day {0};
+
+    switch (iterator->kind){
+        case KISS_SCHEDULE_MONTHLY_ON_DAY:
+            day = iterator->day;
+            break;
+        case KISS_SCHEDULE_MONTHLY_LAST_DAY:
+            day = month_length;
+            break;
+        case KISS_SCHEDULE_MONTHLY_NTH_WEEK_DAY:
+            // first day of the month that is the right week day, then move forward by full weeks
+            if (iterator->week_day >= iterator->month_first_week_day){
+                day = static_cast<uint8_t>(1 + iterator->week_day - iterator->month_first_week_day);
+            }
+            else{
+                day = static_cast<uint8_t>(1 + iterator->week_day + 7 - iterator->month_first_week_day);
+            }
+            day = static_cast<uint8_t>(day + 7 * (iterator->day - 1));
+            break;
+        default:
+            break;
+    }
+
+    if (day > month_length){
+        return 0;
+    }
+    return day;
+}
+
+// starting from the current month of the iterator, find the first month with an occurrence and set next_occurrence
+// the init functions check the arguments, so that every schedule has occurrences at least every few months
+static void schedule_find_monthly_occurrence(kiss_schedule_iterator *const iterator){
+    while (true){
+        uint8_t const day = schedule_day_in_current_month(iterator);
+        if (day != 0){
+            iterator->next_occurrence = iterator->month_start + static_cast<kiss_time_t>(day - 1) * SECS_PER_DAY + iterator->time_of_day;
+            return;
+        }
+        schedule_move_to_next_month(iterator);
+    }
+}
+
+static uint32_t schedule_time_of_day(uint8_t const hour, uint8_t const minute, uint8_t const second){
+    return static_cast<uint32_t>(hour * SECS_PER_HOUR + minute * SECS_PER_MIN + second);
+}
+
+static bool schedule_time_of_day_is_valid(uint8_t const hour, uint8_t const minute, uint8_t const second){
+    return hour < 24 && minute < 60 && second < 60;
+}
+
+// common initialization for all the monthly schedules; this is the only place where we decode a calendar
+static void schedule_init_monthly(kiss_schedule_iterator *const iterator, kiss_time_t const posix_start,
+                                  uint8_t const kind, uint8_t const day, uint8_t const week_day,
+                                  uint8_t const hour, uint8_t const minute, uint8_t const second){
+    kiss_calendar_time calendar_start;
+    posix_to_calendar(posix_start, &calendar_start);
+
+    iterator->kind = kind;
+    iterator->day = day;
+    iterator->week_day = week_day;
+    iterator->step = 0;
+    iterator->time_of_day = schedule_time_of_day(hour, minute, second);
+    iterator->year = calendar_start.year;
+    iterator->month = calendar_start.month;
+    iterator->month_start = posix_start
+                            - static_cast<kiss_time_t>(calendar_start.day - 1) * SECS_PER_DAY
+                            - schedule_time_of_day(calendar_start.hour, calendar_start.minute, calendar_start.second);
+    iterator->month_first_week_day = day_of_week(iterator->month_start);
+
+    schedule_find_monthly_occurrence(iterator);
+    while (iterator->next_occurrence < posix_start){
+        schedule_move_to_next_month(iterator);
+        schedule_find_monthly_occurrence(iterator);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// functions
+
+KISS_POSIX_TIME_INLINE bool schedule_init_every_n_seconds(kiss_schedule_iterator *const iterator, kiss_time_t const posix_start, kiss_time_t const step){
+    if (step == 0){
+        return false;
+    }
+
+    *iterator = {};
+    iterator->kind = KISS_SCHEDULE_EVERY_N_SECONDS;
+    iterator->next_occurrence = posix_start;
+    iterator->step = step;
+    return true;
+}
+
+KISS_POSIX_TIME_INLINE bool schedule_init_daily(kiss_schedule_iterator *const iterator, kiss_time_t const posix_start,
+                                                uint8_t const hour, uint8_t const minute, uint8_t const second){
+    if (!schedule_time_of_day_is_valid(hour, minute, second)){
+        return false;
+    }
+
+    *iterator = {};
+    iterator->kind = KISS_SCHEDULE_DAILY;
+    iterator->step = SECS_PER_DAY;
+    iterator->time_of_day = schedule_time_of_day(hour, minute, second);
+    iterator->next_occurrence = posix_start - posix_start % SECS_PER_DAY + iterator->time_of_day;
+    if (iterator->next_occurrence < posix_start){
+        iterator->next_occurrence += SECS_PER_DAY;
+    }
+    return true;
+}
+
+KISS_POSIX_TIME_INLINE bool schedule_init_monthly_on_day(kiss_schedule_iterator *const iterator, kiss_time_t const posix_start, uint8_t const day,
+                                                         uint8_t const hour, uint8_t const minute, uint8_t const second){
+    // a day that no month has would never match
+    if (day < 1 || day > 31 || !schedule_time_of_day_is_valid(hour, minute, second)){
+        return false;
+    }
+    schedule_init_monthly(iterator, posix_start, KISS_SCHEDULE_MONTHLY_ON_DAY, day, 0, hour, minute, second);
+    return true;
+}
+
+KISS_POSIX_TIME_INLINE bool schedule_init_monthly_last_day(kiss_schedule_iterator *const iterator, kiss_time_t const posix_start,
+                                                           uint8_t const hour, uint8_t const minute, uint8_t const second){
+    if (!schedule_time_of_day_is_valid(hour, minute, second)){
+        return false;
+    }
+    schedule_init_monthly(iterator, posix_start, KISS_SCHEDULE_MONTHLY_LAST_DAY, 0, 0, hour, minute, second);
+    return true;
+}
+
+KISS_POSIX_TIME_INLINE bool schedule_init_monthly_nth_week_day(kiss_schedule_iterator *const iterator, kiss_time_t const posix_start,
+                                                               uint8_t const nth, uint8_t const week_day,
+                                                               uint8_t const hour, uint8_t const minute, uint8_t const second){
+    // a 6th week day would never match, and the day computation needs nth and week_day in range
+    if (nth < 1 || nth > 5 || week_day < 1 || week_day > 7 || !schedule_time_of_day_is_valid(hour, minute, second)){
+        return false;
+    }
+    schedule_init_monthly(iterator, posix_start, KISS_SCHEDULE_MONTHLY_NTH_WEEK_DAY, nth, week_day, hour, minute, second);
+    return true;
+}
+
+KISS_POSIX_TIME_INLINE kiss_time_t schedule_next(kiss_schedule_iterator *const iterator){
+    kiss_time_t const result = iterator->next_occurrence;
+
+    if (iterator->kind == KISS_SCHEDULE_EVERY_N_SECONDS || iterator->kind == KISS_SCHEDULE_DAILY){
+        iterator->next_occurrence += iterator->step;
+    }
+    else{
+        schedule_move_to_next_month(iterator);
+        schedule_find_monthly_occurrence(iterator);
+    }
+
+    return result;
+}
+
+KISS_POSIX_TIME_INLINE void schedule_fill(kiss_schedule_iterator *const iterator, kiss_time_t *const posix_out, size_t const n_occurrences){
+    // fixed step schedules: no need to go through the switch for each occurrence
+    if (iterator->kind == KISS_SCHEDULE_EVERY_N_SECONDS || iterator->kind == KISS_SCHEDULE_DAILY){
+        kiss_time_t current = iterator->next_occurrence;
+        for (size_t i=0; i<n_occurrences; i++){
+            posix_out[i] = current;
+            current += iterator->step;
+        }
+        iterator->next_occurrence = current;
+        return;
+    }
+
+    for (size_t i=0; i<n_occurrences; i++){
+        posix_out[i] = schedule_next(iterator);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// cron internal helpers
+
+// index of the lowest set bit, mask must not be 0
+static uint8_t cron_lowest_bit(uint64_t const mask){
+    #if defined(__GNUC__)
+        return static_cast<uint8_t>(__builtin_ctzll(mask));
+    #else
+        uint8_t index {0};
+        while (((mask >> index) & 1) == 0){
+            index++;
+        }
+        return index;
+    #endif
+}
+
+static bool cron_parse_number(char const **const cursor, uint8_t *const number_out){
+    uint16_t number {0};
+    uint8_t n_digits {0};
+
+    while (**cursor >= '0' && **cursor <= '9'){
+        number = static_cast<uint16_t>(number * 10 + (**cursor - '0'));
+        n_digits++;
+        (*cursor)++;
+        if (n_digits > 2){
+            return false;
+        }
+    }
+
+    *number_out = static_cast<uint8_t>(number);
+    return n_digits > 0;
+}
+
+// parse a single field, ending at a space or at the end of the expression, into a mask where bit i is value i
+static bool cron_parse_field(char const **const cursor, uint8_t const min_value, uint8_t const max_value,
+                             uint64_t *const mask_out, bool *const restricted_out){
+    *mask_out = 0;
+    *restricted_out = (**cursor != '*');
+
+    while (true){
+        uint8_t first {min_value};
+        uint8_t last {max_value};
+        uint8_t step {1};
+
+        if (**cursor == '*'){
+            (*cursor)++;
+        }
+        else{
+            if (!cron_parse_number(cursor, &first)){
+                return false;
+            }
+            last = first;
+            if (**cursor == '-'){
+                (*cursor)++;
+                if (!cron_parse_number(cursor, &last)){
+                    return false;
+                }
+            }
+            else if (**cursor == '/'){
+                // "a/n" means from a to the end of the range, every n
+                last = max_value;
+            }
+        }
+
+        if (**cursor == '/'){
+            (*cursor)++;
+            if (!cron_parse_number(cursor, &step) || step == 0){
+                return false;
+            }
+        }
+
+        if (first < min_value || last > max_value || first > last){
+            return false;
+        }
+
+        for (uint16_t value=first; value<=last; value = static_cast<uint16_t>(value + step)){
+            *mask_out |= static_cast<uint64_t>(1) << value;
+        }
+
+        if (**cursor == ','){
+            (*cursor)++;
+        }
+        else if (**cursor == ' ' || **cursor == '\t' || **cursor == '\0'){
+            return true;
+        }
+        else{
+            return false;
+        }
+    }
+}
+
+static void cron_skip_spaces(char const **const cursor){
+    while (**cursor == ' ' || **cursor == '\t'){
+        (*cursor)++;
+    }
+}
+
+static bool cron_day_matches(kiss_cron_rule const *const rule, uint8_t const day, uint8_t const week_day){
+    bool const day_matches = ((rule->days >> (day - 1)) & 1) != 0;
+    bool const week_day_matches = ((rule->week_days >> (week_day - 1)) & 1) != 0;
+
+    if ((rule->flags & KISS_CRON_DAYS_RESTRICTED) && (rule->flags & KISS_CRON_WEEK_DAYS_RESTRICTED)){
+        return day_matches || week_day_matches;
+    }
+    return day_matches && week_day_matches;
+}
+
+// mask of the days of the given month that match the rule, bit i is day i+1
+static uint32_t cron_days_mask_in_month(kiss_cron_rule const *const rule, uint16_t const year, uint8_t const month){
+    uint8_t const month_length = is_leap_year(year) ? days_per_month_leap[month-1] : days_per_month_normal[month-1];
+    uint32_t const month_mask = (static_cast<uint32_t>(1) << month_length) - 1;
+
+    // which days of this month have an allowed week day? a given week day repeats every 7 days,
+    // i.e. at bits k, k+7, k+14, k+21, k+28
+    kiss_calendar_time const first_of_month {year, month, 1, 0, 0, 0};
+    uint8_t const first_week_day = day_of_week(&first_of_month);
+    uint32_t week_days_mask {0};
+    for (uint8_t k=0; k<7; k++){
+        uint8_t const week_day = static_cast<uint8_t>((first_week_day - 1 + k) % 7);
+        if ((rule->week_days >> week_day) & 1){
+            week_days_mask |= static_cast<uint32_t>(0x10204081) << k;
+        }
+    }
+
+    if ((rule->flags & KISS_CRON_DAYS_RESTRICTED) && (rule->flags & KISS_CRON_WEEK_DAYS_RESTRICTED)){
+        return (rule->days | week_days_mask) & month_mask;
+    }
+    return rule->days & week_days_mask & month_mask;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// cron functions
+
+KISS_POSIX_TIME_INLINE bool cron_compile(char const *const expression, kiss_cron_rule *const rule_out){
+    char const *cursor {expression};
+    uint64_t masks[5];
+    bool restricted[5];
+    uint8_t const min_values[5] {0, 0, 1, 1, 0};
+    uint8_t const max_values[5] {59, 23, 31, 12, 7};
+
+    for (size_t field=0; field<5; field++){
+        cron_skip_spaces(&cursor);
+        if (!cron_parse_field(&cursor, min_values[field], max_values[field], &masks[field], &restricted[field])){
+            return false;
+        }
+    }
+    cron_skip_spaces(&cursor);
+    if (*cursor != '\0'){
+        return false;
+    }
+
+    rule_out->minutes = masks[0];
+    rule_out->hours = static_cast<uint32_t>(masks[1]);
+    rule_out->days = static_cast<uint32_t>(masks[2] >> 1);
+    rule_out->months = static_cast<uint16_t>(masks[3] >> 1);
+    // cron counts sunday as 0 or 7 and monday as 1, we count monday as 1 and sunday as 7
+    rule_out->week_days = static_cast<uint8_t>(((masks[4] >> 1) & 0x3F) | (((masks[4] | (masks[4] >> 7)) & 1) << 6));
+    rule_out->flags = 0;
+    if (restricted[2]){
+        rule_out->flags |= KISS_CRON_DAYS_RESTRICTED;
+    }
+    if (restricted[4]){
+        rule_out->flags |= KISS_CRON_WEEK_DAYS_RESTRICTED;
+    }
+
+    return true;
+}
+
+KISS_POSIX_TIME_INLINE bool cron_matches(kiss_cron_rule const *const rule, kiss_time_t const posix_in){
+    // the cheap fields first: most of the time, we can answer without decoding the date
+    uint8_t const minute = static_cast<uint8_t>( (posix_in / SECS_PER_MIN) % 60 );
+    uint8_t const hour = static_cast<uint8_t>( (posix_in / SECS_PER_HOUR) % 24 );
+    if ((((rule->minutes >> minute) & 1) == 0) || (((rule->hours >> hour) & 1) == 0)){
+        return false;
+    }
+
+    kiss_calendar_time working_calendar;
+    posix_to_calendar(posix_in, &working_calendar);
+    if (((rule->months >> (working_calendar.month - 1)) & 1) == 0){
+        return false;
+    }
+
+    return cron_day_matches(rule, working_calendar.day, day_of_week(posix_in));
+}
+
+KISS_POSIX_TIME_INLINE bool cron_next_fire_after(kiss_cron_rule const *const rule, kiss_time_t const posix_in, kiss_time_t *const posix_out){
+    kiss_calendar_time working_calendar;
+    posix_to_calendar(posix_in - posix_in % SECS_PER_MIN + SECS_PER_MIN, &working_calendar);
+
+    uint16_t year {working_calendar.year};
+    uint8_t month {working_calendar.month};
+    uint8_t day {working_calendar.day};
+    uint8_t hour {working_calendar.hour};
+    uint8_t minute {working_calendar.minute};
+
+    // a rule on the 29th of february may need to wait 8 years (for example, from 2096 to 2104)
+    for (uint16_t n_months=0; n_months<12*9; n_months++){
+        if ((rule->months >> (month - 1)) & 1){
+            // candidate days: the matching days of this month, from the current day on
+            uint32_t days = cron_days_mask_in_month(rule, year, month) & ~((static_cast<uint32_t>(1) << (day - 1)) - 1);
+
+            while (days != 0){
+                uint8_t const candidate_day = static_cast<uint8_t>(cron_lowest_bit(days) + 1);
+                if (candidate_day != day){
+                    hour = 0;
+                    minute = 0;
+                }
+
+                uint32_t hours = rule->hours & ~((static_cast<uint32_t>(1) << hour) - 1);
+                while (hours != 0){
+                    uint8_t const candidate_hour = cron_lowest_bit(hours);
+                    if (candidate_hour != hour){
+                        minute = 0;
+                    }
+
+                    uint64_t const minutes = rule->minutes & ~((static_cast<uint64_t>(1) << minute) - 1);
+                    if (minutes != 0){
+                        kiss_calendar_time const result {year, month, candidate_day, candidate_hour, cron_lowest_bit(minutes), 0};
+                        *posix_out = calendar_to_posix(&result);
+                        return true;
+                    }
+
+                    hours &= hours - 1;
+                    minute = 0;
+                }
+
+                days &= days - 1;
+                hour = 0;
+                minute = 0;
+            }
+        }
+
+        // nothing left in this month, go to the start of the next one
+        day = 1;
+        hour = 0;
+        minute = 0;
+        month = static_cast<uint8_t>(month + 1);
+        if (month > 12){
+            month = 1;
+            year = static_cast<uint16_t>(year + 1);
+        }
+    }
+
+    return false;
+}
+
+#endif
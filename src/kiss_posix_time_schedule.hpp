@@ -0,0 +1,123 @@
+#ifndef KISS_POSIX_TIME_SCHEDULE
+#define KISS_POSIX_TIME_SCHEDULE
+
+#include "kiss_posix_time_utils.hpp"
+
+/*
+
+Expansion of recurring schedules (every N seconds, every day at a given time, a given day of each month,
+the last day of each month, the n-th week day of each month) into concrete posix times, and matching
+of posix times against cron rules.
+
+The iterators only call posix_to_calendar once, when they are initialized; after that, the day / month / year
+state is carried forward from one occurrence to the next, so that getting the next occurrence is only a few
+additions and comparisons. No dynamic allocation: the iterator is a small struct owned by the caller.
+
+*/
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// data structures
+
+// the different kinds of recurring schedules
+enum kiss_schedule_kind : uint8_t
+{
+    KISS_SCHEDULE_EVERY_N_SECONDS,
+    KISS_SCHEDULE_DAILY,
+    KISS_SCHEDULE_MONTHLY_ON_DAY,
+    KISS_SCHEDULE_MONTHLY_LAST_DAY,
+    KISS_SCHEDULE_MONTHLY_NTH_WEEK_DAY
+};
+
+// the state of a schedule iterator; initialize it with one of the schedule_init_* functions below,
+// and do not modify the fields by hand
+struct kiss_schedule_iterator
+{
+    kiss_time_t next_occurrence;  // the next occurrence that will be returned
+    kiss_time_t step;             // the step in seconds, for the every N seconds and daily schedules
+    kiss_time_t month_start;      // posix time of the 1st of the current month at 00:00:00, for the monthly schedules
+    uint32_t time_of_day;         // seconds since midnight of each occurrence, for the monthly schedules
+    uint16_t year;                // current year, for the monthly schedules
+    uint8_t month;                // current month, for the monthly schedules
+    uint8_t month_first_week_day; // week day of the 1st of the current month, 1 is monday, ..., 7 is sunday
+    uint8_t kind;                 // one of the kiss_schedule_kind
+    uint8_t day;                  // day of the month for KISS_SCHEDULE_MONTHLY_ON_DAY, n-th occurrence for KISS_SCHEDULE_MONTHLY_NTH_WEEK_DAY
+    uint8_t week_day;             // week day for KISS_SCHEDULE_MONTHLY_NTH_WEEK_DAY, 1 is monday, ..., 7 is sunday
+};
+
+// a compiled cron rule: one bit per allowed value of each field
+struct kiss_cron_rule
+{
+    uint64_t minutes;   // bit i set: minute i is allowed, 0 to 59
+    uint32_t hours;     // bit i set: hour i is allowed, 0 to 23
+    uint32_t days;      // bit i set: day of month i+1 is allowed, 1 to 31
+    uint16_t months;    // bit i set: month i+1 is allowed, 1 to 12
+    uint8_t week_days;  // bit i set: week day i+1 is allowed, 1 is monday, ..., 7 is sunday
+    uint8_t flags;      // KISS_CRON_DAYS_RESTRICTED and / or KISS_CRON_WEEK_DAYS_RESTRICTED
+};
+
+// as in the usual cron, if both the day of month and the day of week fields are restricted (i.e. not starting with *),
+// a day matches if it matches either of them; otherwise, it must match both
+static constexpr uint8_t KISS_CRON_DAYS_RESTRICTED      = 1;
+static constexpr uint8_t KISS_CRON_WEEK_DAYS_RESTRICTED = 2;
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// functions
+
+// all the schedule_init_* functions initialize the iterator so that the first occurrence returned is the first
+// occurrence that is at or after posix_start.
+// they return true if success, false if an argument is out of range (then, the iterator is not written to, and must
+// not be used): hour 0 to 23, minute and second 0 to 59, and the ranges given for each schedule.
+
+// every step seconds, starting at posix_start
+// step must be at least 1
+bool schedule_init_every_n_seconds(kiss_schedule_iterator *const iterator, kiss_time_t const posix_start, kiss_time_t const step);
+
+// every day at hour:minute:second
+bool schedule_init_daily(kiss_schedule_iterator *const iterator, kiss_time_t const posix_start,
+                         uint8_t const hour, uint8_t const minute, uint8_t const second);
+
+// every month on the given day (1 to 31) at hour:minute:second;
+// months that do not have this day (for example, the 31st in April) are skipped
+bool schedule_init_monthly_on_day(kiss_schedule_iterator *const iterator, kiss_time_t const posix_start, uint8_t const day,
+                                  uint8_t const hour, uint8_t const minute, uint8_t const second);
+
+// every month on the last day of the month at hour:minute:second
+bool schedule_init_monthly_last_day(kiss_schedule_iterator *const iterator, kiss_time_t const posix_start,
+                                    uint8_t const hour, uint8_t const minute, uint8_t const second);
+
+// every month on the n-th (1 to 5) given week day (1 is monday, ..., 7 is sunday) at hour:minute:second,
+// i.e. nth 1 and week_day 1 is "the first monday of each month"; months that do not have
+// a 5th such week day are skipped
+bool schedule_init_monthly_nth_week_day(kiss_schedule_iterator *const iterator, kiss_time_t const posix_start,
+                                        uint8_t const nth, uint8_t const week_day,
+                                        uint8_t const hour, uint8_t const minute, uint8_t const second);
+
+// return the next occurrence, and move the iterator forward
+kiss_time_t schedule_next(kiss_schedule_iterator *const iterator);
+
+// fill the n_occurrences next occurrences into posix_out, and move the iterator forward
+void schedule_fill(kiss_schedule_iterator *const iterator, kiss_time_t *const posix_out, size_t const n_occurrences);
+
+// compile a cron expression with the 5 usual fields "minute hour day_of_month month day_of_week" into a rule,
+// for example "30 2 * * 1-5" is every week day at 02:30
+// each field is a comma separated list of *, a value, or a range a-b, optionally followed by a step /n;
+// day of week 0 and 7 are both sunday, 1 is monday; names (jan, mon, ...) are not supported
+// return true if success, false if the expression is not valid
+bool cron_compile(char const *const expression, kiss_cron_rule *const rule_out);
+
+// does the minute containing posix_in match the rule?
+bool cron_matches(kiss_cron_rule const *const rule, kiss_time_t const posix_in);
+
+// find the first minute strictly after posix_in that matches the rule; whole months, days and hours that
+// cannot match are skipped at once
+// return true if success, false if the rule does not match anything in the next 9 years
+// (for example, the 30th of february)
+bool cron_next_fire_after(kiss_cron_rule const *const rule, kiss_time_t const posix_in, kiss_time_t *const posix_out);
+
+#ifdef KISS_POSIX_TIME_HEADER_ONLY
+  #include "kiss_posix_time_schedule.cpp"
+#endif
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef KISS_POSIX_TIME_SERIES_IMPLEMENTATION
+#define KISS_POSIX_TIME_SERIES_IMPLEMENTATION
+
+#include "kiss_posix_time_series.hpp"
+#include "kiss_posix_time_era_helpers.hpp"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// internal helpers
+
+// the histograms count into 4 interleaved partial histograms: consecutive values often fall in the same bucket,
+// and incrementing the same counter 4 times in a row makes each increment wait for the previous one
+static constexpr size_t SERIES_N_PARTIALS = 4;
+
+// days since epoch to year and month, in O(1), with the 1st march years of era_days_to_march_year
+static void series_days_to_year_month(uint64_t const days, uint16_t *const year_out, uint8_t *const month_out){
+    uint64_t year {0};
+    uint64_t day_of_year {0};
+    era_days_to_march_year(days + DAYS_FROM_0000_03_01_TO_EPOCH, &year, &day_of_year);
+    uint64_t const shifted_month = (5 * day_of_year + 2) / 153; // 0 is march, ..., 11 is february
+    uint8_t const month = static_cast<uint8_t>(shifted_month < 10 ? shifted_month + 3 : shifted_month - 9);
+
+    *month_out = month;
+    *year_out = static_cast<uint16_t>(year + (month <= 2 ? 1 : 0));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// histograms
+
+KISS_POSIX_TIME_INLINE void histogram_hour_of_day(kiss_time_t const *const posix_in, size_t const n_values, uint64_t *const counts){
+    uint64_t partial_counts[SERIES_N_PARTIALS][24] {};
+
+    size_t i {0};
+    for (; i+SERIES_N_PARTIALS<=n_values; i+=SERIES_N_PARTIALS){
+        for (size_t k=0; k<SERIES_N_PARTIALS; k++){
+            partial_counts[k][posix_in[i+k] % SECS_PER_DAY / SECS_PER_HOUR]++;
+        }
+    }
+    for (; i<n_values; i++){
+        partial_counts[0][posix_in[i] % SECS_PER_DAY / SECS_PER_HOUR]++;
+    }
+
+    for (size_t k=0; k<SERIES_N_PARTIALS; k++){
+        histogram_merge(counts, partial_counts[k], 24);
+    }
+}
+
+KISS_POSIX_TIME_INLINE void histogram_day_of_week(kiss_time_t const *const posix_in, size_t const n_values, uint64_t *const counts){
+    uint64_t partial_counts[SERIES_N_PARTIALS][7] {};
+
+    // 1st jan 1970 was a thursday, i.e. index 3
+    size_t i {0};
+    for (; i+SERIES_N_PARTIALS<=n_values; i+=SERIES_N_PARTIALS){
+        for (size_t k=0; k<SERIES_N_PARTIALS; k++){
+            partial_counts[k][(posix_in[i+k] / SECS_PER_DAY + 3) % 7]++;
+        }
+    }
+    for (; i<n_values; i++){
+        partial_counts[0][(posix_in[i] / SECS_PER_DAY + 3) % 7]++;
+    }
+
+    for (size_t k=0; k<SERIES_N_PARTIALS; k++){
+        histogram_merge(counts, partial_counts[k], 7);
+    }
+}
+
+KISS_POSIX_TIME_INLINE void histogram_month(kiss_time_t const *const posix_in, size_t const n_values, uint64_t *const counts){
+    uint64_t partial_counts[SERIES_N_PARTIALS][12] {};
+    uint16_t year;
+    uint8_t month;
+
+    size_t i {0};
+    for (; i+SERIES_N_PARTIALS<=n_values; i+=SERIES_N_PARTIALS){
+        for (size_t k=0; k<SERIES_N_PARTIALS; k++){
+            series_days_to_year_month(posix_in[i+k] / SECS_PER_DAY, &year, &month);
+            partial_counts[k][month - 1]++;
+        }
+    }
+    for (; i<n_values; i++){
+        series_days_to_year_month(posix_in[i] / SECS_PER_DAY, &year, &month);
+        partial_counts[0][month - 1]++;
+    }
+
+    for (size_t k=0; k<SERIES_N_PARTIALS; k++){
+        histogram_merge(counts, partial_counts[k], 12);
+    }
+}
+
+KISS_POSIX_TIME_INLINE void histogram_year(kiss_time_t const *const posix_in, size_t const n_values,
+                                           uint16_t const first_year, size_t const n_years, uint64_t *const counts){
+    uint16_t year;
+    uint8_t month;
+
+    // the number of years is not bounded, so no partial histograms on the stack here
+    for (size_t i=0; i<n_values; i++){
+        series_days_to_year_month(posix_in[i] / SECS_PER_DAY, &year, &month);
+        if (year >= first_year && static_cast<size_t>(year - first_year) < n_years){
+            counts[year - first_year]++;
+        }
+    }
+}
+
+KISS_POSIX_TIME_INLINE void histogram_merge(uint64_t *const counts, uint64_t const *const other_counts, size_t const n_buckets){
+    for (size_t i=0; i<n_buckets; i++){
+        counts[i] += other_counts[i];
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// sorted range queries
+
+KISS_POSIX_TIME_INLINE size_t sorted_lower_bound(kiss_time_t const *const sorted_in, size_t const n_values, kiss_time_t const posix_in){
+    if (n_values == 0){
+        return 0;
+    }
+
+    // at each step, keep the half that contains the answer; the compiler turns the choice into a conditional move
+    size_t base {0};
+    size_t length {n_values};
+    while (length > 1){
+        size_t const half = length / 2;
+        base = (sorted_in[base + half - 1] < posix_in) ? base + half : base;
+        length -= half;
+    }
+
+    return base + (sorted_in[base] < posix_in ? 1 : 0);
+}
+
+KISS_POSIX_TIME_INLINE void sorted_range_between(kiss_time_t const *const sorted_in, size_t const n_values,
+                                                 kiss_time_t const posix_start, kiss_time_t const posix_end, kiss_row_range *const range_out){
+    range_out->begin = sorted_lower_bound(sorted_in, n_values, posix_start);
+    range_out->end = sorted_lower_bound(sorted_in, n_values, posix_end);
+    if (range_out->end < range_out->begin){
+        range_out->end = range_out->begin;
+    }
+}
+
+// rows from the calendar time start_in included, for length seconds; the end is counted from the start, rather than
+// built as a calendar time, that would not fit in the calendar at the end of year 65535
+// an empty range at the end of the rows if start_in is not valid
+static void series_range_from_calendar(kiss_time_t const *const sorted_in, size_t const n_values,
+                                       kiss_calendar_time const *const start_in, kiss_time_t const length, kiss_row_range *const range_out){
+    kiss_time_t posix_start;
+    if (calendar_to_posix_checked(start_in, &posix_start) != KISS_CONVERSION_OK){
+        range_out->begin = n_values;
+        range_out->end = n_values;
+        return;
+    }
+    sorted_range_between(sorted_in, n_values, posix_start, posix_start + length, range_out);
+}
+
+KISS_POSIX_TIME_INLINE void sorted_range_year(kiss_time_t const *const sorted_in, size_t const n_values,
+                                              uint16_t const year, kiss_row_range *const range_out){
+    kiss_calendar_time const start {year, 1, 1, 0, 0, 0};
+    uint32_t const days_in_year = is_leap_year(year) ? days_leap_year : days_normal_year;
+    series_range_from_calendar(sorted_in, n_values, &start, days_in_year * SECS_PER_DAY, range_out);
+}
+
+KISS_POSIX_TIME_INLINE void sorted_range_month(kiss_time_t const *const sorted_in, size_t const n_values,
+                                               uint16_t const year, uint8_t const month, kiss_row_range *const range_out){
+    kiss_calendar_time const start {year, month, 1, 0, 0, 0};
+    // look up the length only for a valid month; the checked conversion rejects the others
+    uint8_t const *const days_per_month = is_leap_year(year) ? days_per_month_leap : days_per_month_normal;
+    uint8_t const days_in_month = (month >= 1 && month <= 12) ? days_per_month[month - 1] : 0;
+    series_range_from_calendar(sorted_in, n_values, &start, days_in_month * SECS_PER_DAY, range_out);
+}
+
+KISS_POSIX_TIME_INLINE void sorted_range_day(kiss_time_t const *const sorted_in, size_t const n_values,
+                                             uint16_t const year, uint8_t const month, uint8_t const day, kiss_row_range *const range_out){
+    kiss_calendar_time const start {year, month, day, 0, 0, 0};
+    series_range_from_calendar(sorted_in, n_values, &start, SECS_PER_DAY, range_out);
+}
+
+KISS_POSIX_TIME_INLINE void sorted_range_hour(kiss_time_t const *const sorted_in, size_t const n_values,
+                                              uint16_t const year, uint8_t const month, uint8_t const day, uint8_t const hour,
+                                              kiss_row_range *const range_out){
+    kiss_calendar_time const start {year, month, day, hour, 0, 0};
+    series_range_from_calendar(sorted_in, n_values, &start, SECS_PER_HOUR, range_out);
+}
+
+KISS_POSIX_TIME_INLINE void sorted_ranges_between(kiss_time_t const *const sorted_in, size_t const n_values,
+                                                  kiss_time_t const *const posix_starts, kiss_time_t const *const posix_ends,
+                                                  size_t const n_ranges, kiss_row_range *const ranges_out){
+    for (size_t i=0; i<n_ranges; i++){
+        sorted_range_between(sorted_in, n_values, posix_starts[i], posix_ends[i], &ranges_out[i]);
+    }
+}
+
+#endif
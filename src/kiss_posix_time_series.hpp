@@ -0,0 +1,86 @@
+#ifndef KISS_POSIX_TIME_SERIES
+#define KISS_POSIX_TIME_SERIES
+
+#include "kiss_posix_time_utils.hpp"
+
+/*
+
+Tools for working on large arrays of posix times.
+
+- histograms: count the posix times per hour of day, day of week, month or year. Only the fields that are needed
+are computed, directly from the posix times, instead of going through a full posix_to_calendar for each value.
+The histogram functions add to the counts that are already in the counts array (so, zero it first), so that the same
+counts array can be used over several batches. To use several threads, give each thread its own counts array over
+its part of the data, and merge the counts arrays at the end with histogram_merge.
+
+- sorted range queries: find which rows of a sorted array of posix times fall in a given year, month, day or hour.
+Only the bounds of the range are converted with calendar_to_posix, and the rows are found by binary search,
+without looking at the rows in between.
+
+*/
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// histograms
+
+// counts[i] is incremented for each value in hour i, 0 to 23
+void histogram_hour_of_day(kiss_time_t const *const posix_in, size_t const n_values, uint64_t *const counts);
+
+// counts[i] is incremented for each value in week day i+1, i.e. counts[0] is monday, ..., counts[6] is sunday
+void histogram_day_of_week(kiss_time_t const *const posix_in, size_t const n_values, uint64_t *const counts);
+
+// counts[i] is incremented for each value in month i+1, i.e. counts[0] is january, ..., counts[11] is december
+void histogram_month(kiss_time_t const *const posix_in, size_t const n_values, uint64_t *const counts);
+
+// counts[i] is incremented for each value in year first_year + i, for i in 0 to n_years - 1; values outside of
+// these years are not counted
+void histogram_year(kiss_time_t const *const posix_in, size_t const n_values,
+                    uint16_t const first_year, size_t const n_years, uint64_t *const counts);
+
+// add the counts of other_counts to counts, over n_buckets buckets
+void histogram_merge(uint64_t *const counts, uint64_t const *const other_counts, size_t const n_buckets);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// sorted range queries
+
+// all the functions in this section need sorted_in to be sorted in increasing order
+
+// a range of rows, from begin included to end excluded; empty if begin == end
+struct kiss_row_range
+{
+    size_t begin;
+    size_t end;
+};
+
+// index of the first row that is not before posix_in (n_values if all rows are before posix_in);
+// this is a branchless binary search, i.e. the loop has no data dependent branch to mispredict
+size_t sorted_lower_bound(kiss_time_t const *const sorted_in, size_t const n_values, kiss_time_t const posix_in);
+
+// rows from posix_start included to posix_end excluded
+void sorted_range_between(kiss_time_t const *const sorted_in, size_t const n_values,
+                          kiss_time_t const posix_start, kiss_time_t const posix_end, kiss_row_range *const range_out);
+
+// rows in the given year, month, day, or hour
+// the fields are checked as by calendar_to_posix_checked; if they are not valid (for example month 13, or a year
+// before EPOCH_START), the range is empty, with begin and end both n_values
+void sorted_range_year(kiss_time_t const *const sorted_in, size_t const n_values,
+                       uint16_t const year, kiss_row_range *const range_out);
+void sorted_range_month(kiss_time_t const *const sorted_in, size_t const n_values,
+                        uint16_t const year, uint8_t const month, kiss_row_range *const range_out);
+void sorted_range_day(kiss_time_t const *const sorted_in, size_t const n_values,
+                      uint16_t const year, uint8_t const month, uint8_t const day, kiss_row_range *const range_out);
+void sorted_range_hour(kiss_time_t const *const sorted_in, size_t const n_values,
+                       uint16_t const year, uint8_t const month, uint8_t const day, uint8_t const hour,
+                       kiss_row_range *const range_out);
+
+// bulk version of sorted_range_between, over n_ranges ranges [posix_starts[i], posix_ends[i])
+void sorted_ranges_between(kiss_time_t const *const sorted_in, size_t const n_values,
+                           kiss_time_t const *const posix_starts, kiss_time_t const *const posix_ends,
+                           size_t const n_ranges, kiss_row_range *const ranges_out);
+
+#ifdef KISS_POSIX_TIME_HEADER_ONLY
+  #include "kiss_posix_time_series.cpp"
+#endif
+
+#endif
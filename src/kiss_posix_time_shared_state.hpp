@@ -0,0 +1,36 @@
+#ifndef KISS_POSIX_TIME_SHARED_STATE
+#define KISS_POSIX_TIME_SHARED_STATE
+
+/*
+
+Internal accessors to the process wide state of the modules that have one; this is not part of the API. Each state is
+a function local static in a function with external linkage, so that there is a single one also in header-only mode;
+these functions are declared here, with a kiss_ prefix, so that they are the only external symbols of the library
+that are not in the API. The states themselves are defined in the .cpp of their module.
+
+*/
+
+// the table of installed backends, see kiss_posix_time_backends.cpp
+struct kiss_backend_state;
+kiss_backend_state *kiss_backend_shared_state();
+
+// the cache of the "now" clock, see kiss_posix_time_clock.cpp
+#ifndef ARDUINO
+struct kiss_clock_state;
+kiss_clock_state *kiss_clock_shared_state();
+#endif
+
+#ifdef KISS_POSIX_TIME_INSTRUMENTATION
+
+#include <atomic>
+
+// the per thread blocks of counters, see kiss_posix_time_instrumentation.cpp: the head of the list of all blocks, a
+// free or new block, and the block of the calling thread
+struct kiss_instrumentation_block;
+std::atomic<kiss_instrumentation_block *> *kiss_instrumentation_blocks();
+kiss_instrumentation_block *kiss_instrumentation_acquire_block();
+kiss_instrumentation_block *kiss_instrumentation_thread_block();
+
+#endif
+
+#endif
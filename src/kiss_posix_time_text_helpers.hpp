@@ -0,0 +1,99 @@
+#ifndef KISS_POSIX_TIME_TEXT_HELPERS
+#define KISS_POSIX_TIME_TEXT_HELPERS
+
+#include "kiss_posix_time_utils.hpp"
+#include "kiss_posix_time_extras.hpp"
+
+/*
+
+Internal helpers shared by the modules that write and read time strings (extras, format, fixed_format, decimal): digits,
+validity masks, and the end of a parse; this is not part of the API. Everything here is inline, so that this is header only, also when the
+library is compiled.
+
+*/
+
+// "00" to "99", so that the digits are written 2 at a time
+constexpr char TEXT_DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+// write the n_digits last decimal digits of value, zero padded, to buffer_out; no null byte
+inline void text_write_digits(char *const buffer_out, uint32_t value, uint8_t const n_digits){
+    uint8_t position {n_digits};
+    while (position >= 2){
+        position = static_cast<uint8_t>(position - 2);
+        uint32_t const pair = value % 100;
+        buffer_out[position] = TEXT_DIGIT_PAIRS[2 * pair];
+        buffer_out[position + 1] = TEXT_DIGIT_PAIRS[2 * pair + 1];
+        value /= 100;
+    }
+    if (position == 1){
+        buffer_out[0] = static_cast<char>('0' + value % 10);
+    }
+}
+
+// read exactly n_digits decimal digits; return false if one of them is not a digit (then, value_out is meaningless)
+inline bool text_read_digits(char const *const text_in, uint8_t const n_digits, uint32_t *const value_out){
+    uint32_t value {0};
+    bool all_digits {true};
+    for (uint8_t i=0; i<n_digits; i++){
+        uint32_t const digit = static_cast<uint32_t>(static_cast<unsigned char>(text_in[i])) - '0';
+        all_digits = all_digits && digit < 10;
+        value = 10 * value + digit;
+    }
+    *value_out = value;
+    return all_digits;
+}
+
+// set bit index % 8 of valid_mask_out[index / 8] if valid, for the batch parsers that go through their entries in order;
+// each byte is cleared at its first entry
+inline void text_set_valid(uint8_t *const valid_mask_out, size_t const index, bool const valid){
+    if (index % 8 == 0){
+        valid_mask_out[index / 8] = 0;
+    }
+    valid_mask_out[index / 8] = static_cast<uint8_t>(valid_mask_out[index / 8] | (static_cast<uint8_t>(valid) << (index % 8)));
+}
+
+// the fields of a parse, before the final checked conversion
+struct kiss_text_parse_state
+{
+    kiss_calendar_time calendar;
+    kiss_time_t posix;      // only if has_posix
+    uint16_t day_of_year;   // 0 if not parsed
+    uint8_t week_day;       // 1 is monday, ..., 7 is sunday; 0 if not parsed
+    bool has_posix;         // the posix time itself was parsed, and the calendar fields are ignored
+};
+
+// the posix time of a parse: the day of the year, if any, sets the month and the day of the calendar, that is then
+// range checked and converted, and the week day, if any, must be the one of the date
+// return false if this is not a valid time (then, posix_out is not written to)
+inline bool text_parse_finish(kiss_text_parse_state *const state, kiss_time_t *const posix_out){
+    kiss_time_t posix {state->posix};
+    if (!state->has_posix){
+        if (state->day_of_year != 0){
+            uint16_t const *const cumulative_days = is_leap_year(state->calendar.year) ? cumulative_days_per_month_leap : cumulative_days_per_month_normal;
+            if (state->day_of_year > cumulative_days[12]){
+                return false;
+            }
+            uint8_t month {1};
+            while (state->day_of_year > cumulative_days[month]){
+                month++;
+            }
+            state->calendar.month = month;
+            state->calendar.day = static_cast<uint8_t>(state->day_of_year - cumulative_days[month - 1]);
+        }
+
+        if (calendar_to_posix_checked(&state->calendar, &posix) != KISS_CONVERSION_OK){
+            return false;
+        }
+    }
+
+    if (state->week_day != 0 && state->week_day != day_of_week(posix)){
+        return false;
+    }
+
+    *posix_out = posix;
+    return true;
+}
+
+#endif
@@ -1,4 +1,9 @@
+#ifndef KISS_POSIX_TIME_UTILS_IMPLEMENTATION
+#define KISS_POSIX_TIME_UTILS_IMPLEMENTATION
+
 #include "kiss_posix_time_utils.hpp"
+#include "kiss_posix_time_instrumentation.hpp"
+#include "kiss_posix_time_era_helpers.hpp"
 
 /*
 
@@ -27,52 +32,403 @@ cumulated days per month. In case flash is really limited, may be helpful.
 
 */
 
-// 1 to use my implementation, 0 to use Oryx
-#define USE_JR_IMPLEMENTATION 1
+// USE_JR_IMPLEMENTATION (in kiss_posix_time_config.hpp) chooses the implementation of calendar_to_posix and
+// posix_to_calendar; both are always available under their own names, see the backends section under
 
 //////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////
 // functions
 
-bool is_leap_year(uint16_t const year_number)
+KISS_POSIX_TIME_INLINE bool is_leap_year(uint16_t const year_number)
 {
     return (year_number % 4 == 0) && (!(year_number % 100 == 0) || (year_number % 400 == 0));
 }
 
-bool calendar_is_valid(kiss_calendar_time const *const calendar_in){
-    uint8_t month_length = is_leap_year(calendar_in->year) ? days_per_month_leap[calendar_in->month-1] : days_per_month_normal[calendar_in->month-1];
+// validity of a calendar without any branch: the month is clamped before looking up the month length,
+// so that even an invalid month never reads out of the tables, and the checks are combined with & rather than &&
+static bool calendar_is_valid_branchless(kiss_calendar_time const *const calendar_in){
+    // unsigned wrap around: month 0 becomes 255, so a single comparison checks 1 to 12; same for the day
+    uint8_t const month_index = static_cast<uint8_t>(calendar_in->month - 1);
+    bool const month_valid = month_index < 12;
+    uint8_t const safe_month_index = month_valid ? month_index : 0;
+    uint8_t const month_length = is_leap_year(calendar_in->year) ? days_per_month_leap[safe_month_index] : days_per_month_normal[safe_month_index];
+
+    return month_valid
+           & (static_cast<uint8_t>(calendar_in->day - 1) < month_length)
+           & (calendar_in->hour <= 23)
+           & (calendar_in->minute <= 59)
+           & (calendar_in->second <= 59);
+}
+
+KISS_POSIX_TIME_INLINE bool calendar_is_valid(kiss_calendar_time const *const calendar_in){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_CALENDAR_IS_VALID, 1);
+    return calendar_is_valid_branchless(calendar_in);
+}
+
+KISS_POSIX_TIME_INLINE size_t calendar_is_valid_batch(kiss_calendar_time const *const calendar_in, size_t const n_entries, uint8_t *const valid_mask_out){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_CALLS, 1);
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_ENTRIES, n_entries);
+    size_t n_valid {0};
+
+    for (size_t byte=0; 8*byte<n_entries; byte++){
+        uint8_t mask {0};
+        for (size_t bit=0; bit<8 && 8*byte+bit<n_entries; bit++){
+            bool const valid = calendar_is_valid_branchless(&calendar_in[8*byte + bit]);
+            mask = static_cast<uint8_t>(mask | (static_cast<uint8_t>(valid) << bit));
+            n_valid += valid;
+        }
+        valid_mask_out[byte] = mask;
+    }
+
+    return n_valid;
+}
+
+// days from EPOCH_START to 1st january of year
+static kiss_time_t days_to_start_of_year(uint16_t const year){
+    uint16_t const year_minus_1 = static_cast<uint16_t>(year - 1);
+    return static_cast<kiss_time_t>(
+        year_minus_1 * 365 + year_minus_1 / 4 - year_minus_1 / 100 + year_minus_1 / 400
+        - 719162  // the value we would get for the expression starting at year 0 instead of 1970
+    );
+}
+
+KISS_POSIX_TIME_INLINE kiss_conversion_status calendar_to_posix_checked(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_CALENDAR_TO_POSIX_CHECKED, 1);
+
+    // check the fields in order, reusing the leap year and month lookups for the conversion itself
+    bool const leap_year = is_leap_year(calendar_in->year);
+    uint8_t const month_index = static_cast<uint8_t>(calendar_in->month - 1);
+
+    if (calendar_in->year < EPOCH_START){
+        return KISS_CONVERSION_INVALID_YEAR;
+    }
+    if (month_index >= 12){
+        return KISS_CONVERSION_INVALID_MONTH;
+    }
+    uint8_t const month_length = leap_year ? days_per_month_leap[month_index] : days_per_month_normal[month_index];
+    if (static_cast<uint8_t>(calendar_in->day - 1) >= month_length){
+        return KISS_CONVERSION_INVALID_DAY;
+    }
+    if (calendar_in->hour > 23){
+        return KISS_CONVERSION_INVALID_HOUR;
+    }
+    if (calendar_in->minute > 59){
+        return KISS_CONVERSION_INVALID_MINUTE;
+    }
+    if (calendar_in->second > 59){
+        return KISS_CONVERSION_INVALID_SECOND;
+    }
+
+    kiss_time_t const days = days_to_start_of_year(calendar_in->year)
+                             + (leap_year ? cumulative_days_per_month_leap[month_index] : cumulative_days_per_month_normal[month_index])
+                             + static_cast<kiss_time_t>(calendar_in->day - 1);
+    *posix_out = days * SECS_PER_DAY + calendar_in->hour * SECS_PER_HOUR + calendar_in->minute * SECS_PER_MIN + calendar_in->second;
+
+    return KISS_CONVERSION_OK;
+}
+
+KISS_POSIX_TIME_INLINE size_t calendar_to_posix_checked_batch(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out,
+                                                              size_t const n_entries, uint8_t *const valid_mask_out){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_CALLS, 1);
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_ENTRIES, n_entries);
+    size_t n_valid {0};
+
+    for (size_t byte=0; 8*byte<n_entries; byte++){
+        uint8_t mask {0};
+        for (size_t bit=0; bit<8 && 8*byte+bit<n_entries; bit++){
+            kiss_calendar_time const *const calendar = &calendar_in[8*byte + bit];
+
+            // no branch: validate and convert with a clamped month, then select the result
+            bool const valid = calendar_is_valid_branchless(calendar) & (calendar->year >= EPOCH_START);
+            uint8_t const month_index = valid ? static_cast<uint8_t>(calendar->month - 1) : 0;
+            kiss_time_t const days = days_to_start_of_year(calendar->year)
+                                     + (is_leap_year(calendar->year) ? cumulative_days_per_month_leap[month_index] : cumulative_days_per_month_normal[month_index])
+                                     + static_cast<kiss_time_t>(calendar->day - 1);
+            kiss_time_t const posix = days * SECS_PER_DAY + calendar->hour * SECS_PER_HOUR + calendar->minute * SECS_PER_MIN + calendar->second;
+
+            posix_out[8*byte + bit] = valid ? posix : 0;
+            mask = static_cast<uint8_t>(mask | (static_cast<uint8_t>(valid) << bit));
+            n_valid += valid;
+        }
+        valid_mask_out[byte] = mask;
+    }
+
+    return n_valid;
+}
+
+// the wide calendar conversions use the era algorithms by Howard Hinnant: "civil from days" (era_days_to_march_year)
+// from posix time, and "days from civil" to posix time
+static void posix_to_wide_calendar_era(kiss_time_t const posix_in, kiss_wide_calendar_time *const calendar_out){
+    calendar_out->second = static_cast<uint8_t>( posix_in % 60 );
+    calendar_out->minute = static_cast<uint8_t>( posix_in / SECS_PER_MIN % 60 );
+    calendar_out->hour = static_cast<uint8_t>( posix_in / SECS_PER_HOUR % 24 );
+
+    uint64_t year {0};
+    uint64_t day_of_year {0};
+    era_days_to_march_year(posix_in / SECS_PER_DAY + DAYS_FROM_0000_03_01_TO_EPOCH, &year, &day_of_year);
+    uint64_t const shifted_month = (5 * day_of_year + 2) / 153;                                                          // 0 is march, ..., 11 is february
+    uint8_t const month = static_cast<uint8_t>(shifted_month < 10 ? shifted_month + 3 : shifted_month - 9);
+
+    calendar_out->day = static_cast<uint8_t>(day_of_year - (153 * shifted_month + 2) / 5 + 1);
+    calendar_out->month = month;
+    calendar_out->year = static_cast<int64_t>(year) + (month <= 2 ? 1 : 0);
+}
+
+KISS_POSIX_TIME_INLINE void posix_to_wide_calendar(kiss_time_t const posix_in, kiss_wide_calendar_time *const calendar_out){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_POSIX_TO_WIDE_CALENDAR, 1);
+    posix_to_wide_calendar_era(posix_in, calendar_out);
+}
+
+KISS_POSIX_TIME_INLINE bool wide_calendar_to_posix(kiss_wide_calendar_time const *const calendar_in, kiss_time_t *const posix_out){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_WIDE_CALENDAR_TO_POSIX, 1);
+
+    // well beyond the end of kiss_time_t, but small enough that nothing overflows in the computations under
+    if (calendar_in->year < EPOCH_START || calendar_in->year > 1000000000000){
+        return false;
+    }
+
+    uint64_t const year = static_cast<uint64_t>(calendar_in->year) - (calendar_in->month <= 2 ? 1 : 0);
+    uint64_t const era = year / 400;
+    uint64_t const year_of_era = year - era * 400;
+    uint64_t const day_of_year = (153 * (calendar_in->month > 2 ? calendar_in->month - 3u : calendar_in->month + 9u) + 2) / 5
+                                 + calendar_in->day - 1;
+    uint64_t const day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    uint64_t const days = era * 146097 + day_of_era - DAYS_FROM_0000_03_01_TO_EPOCH;
+    uint64_t const seconds_in_day = calendar_in->hour * SECS_PER_HOUR + calendar_in->minute * SECS_PER_MIN + calendar_in->second;
+
+    if (days > (UINT64_MAX - seconds_in_day) / SECS_PER_DAY){
+        return false;
+    }
+    *posix_out = days * SECS_PER_DAY + seconds_in_day;
+    return true;
+}
+
+// the day numbers are a shift of the number of days since the epoch; a day number converts to posix time if its days
+// times SECS_PER_DAY fit in kiss_time_t
+static constexpr kiss_time_t MAX_DAYS_IN_KISS_TIME = UINT64_MAX / SECS_PER_DAY;
+
+static bool days_to_posix(kiss_time_t const day_number, kiss_time_t const day_number_of_epoch, kiss_time_t *const posix_out){
+    if (day_number < day_number_of_epoch || day_number - day_number_of_epoch > MAX_DAYS_IN_KISS_TIME){
+        return false;
+    }
+    *posix_out = (day_number - day_number_of_epoch) * SECS_PER_DAY;
+    return true;
+}
+
+// the day of the year from its day counted from 1st march: march to december come after the 59 or 60 days of january
+// and february, january and february are the end of the year counted from 1st march, i.e. the start of the next one
+static kiss_ordinal_date posix_to_ordinal_era(kiss_time_t const posix_in){
+    uint64_t march_year {0};
+    uint64_t day_of_year {0};
+    era_days_to_march_year(posix_in / SECS_PER_DAY + DAYS_FROM_0000_03_01_TO_EPOCH, &march_year, &day_of_year);
+    uint16_t const year = static_cast<uint16_t>(march_year);
+
+    if (day_of_year >= 306){
+        return kiss_ordinal_date {static_cast<uint16_t>(year + 1), static_cast<uint16_t>(day_of_year - 305)};
+    }
+    return kiss_ordinal_date {year, static_cast<uint16_t>(day_of_year + (is_leap_year(year) ? 61 : 60))};
+}
+
+KISS_POSIX_TIME_INLINE kiss_time_t posix_to_julian_day_number(kiss_time_t const posix_in){
+    return posix_in / SECS_PER_DAY + JULIAN_DAY_NUMBER_OF_EPOCH;
+}
+
+KISS_POSIX_TIME_INLINE bool julian_day_number_to_posix(kiss_time_t const julian_day_number_in, kiss_time_t *const posix_out){
+    return days_to_posix(julian_day_number_in, JULIAN_DAY_NUMBER_OF_EPOCH, posix_out);
+}
+
+KISS_POSIX_TIME_INLINE kiss_time_t posix_to_modified_julian_day(kiss_time_t const posix_in){
+    return posix_in / SECS_PER_DAY + MODIFIED_JULIAN_DAY_OF_EPOCH;
+}
+
+KISS_POSIX_TIME_INLINE bool modified_julian_day_to_posix(kiss_time_t const modified_julian_day_in, kiss_time_t *const posix_out){
+    return days_to_posix(modified_julian_day_in, MODIFIED_JULIAN_DAY_OF_EPOCH, posix_out);
+}
+
+KISS_POSIX_TIME_INLINE void posix_to_ordinal(kiss_time_t const posix_in, kiss_ordinal_date *const ordinal_out){
+    *ordinal_out = posix_to_ordinal_era(posix_in);
+}
+
+KISS_POSIX_TIME_INLINE bool ordinal_to_posix(kiss_ordinal_date const *const ordinal_in, kiss_time_t *const posix_out){
+    uint16_t const days_in_year = is_leap_year(ordinal_in->year) ? 366 : 365;
+    if (ordinal_in->year < EPOCH_START || ordinal_in->day_of_year == 0 || ordinal_in->day_of_year > days_in_year){
+        return false;
+    }
+    *posix_out = (days_to_start_of_year(ordinal_in->year) + ordinal_in->day_of_year - 1) * SECS_PER_DAY;
+    return true;
+}
+
+KISS_POSIX_TIME_INLINE void posix_to_julian_day_number_batch(kiss_time_t const *const posix_in, kiss_time_t *const julian_day_number_out, size_t const n_entries){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_CALLS, 1);
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_ENTRIES, n_entries);
+    for (size_t i=0; i<n_entries; i++){
+        julian_day_number_out[i] = posix_in[i] / SECS_PER_DAY + JULIAN_DAY_NUMBER_OF_EPOCH;
+    }
+}
+
+KISS_POSIX_TIME_INLINE void posix_to_modified_julian_day_batch(kiss_time_t const *const posix_in, kiss_time_t *const modified_julian_day_out, size_t const n_entries){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_CALLS, 1);
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_ENTRIES, n_entries);
+    for (size_t i=0; i<n_entries; i++){
+        modified_julian_day_out[i] = posix_in[i] / SECS_PER_DAY + MODIFIED_JULIAN_DAY_OF_EPOCH;
+    }
+}
+
+KISS_POSIX_TIME_INLINE void posix_to_ordinal_batch(kiss_time_t const *const posix_in, kiss_ordinal_date *const ordinal_out, size_t const n_entries){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_CALLS, 1);
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_ENTRIES, n_entries);
+    for (size_t i=0; i<n_entries; i++){
+        ordinal_out[i] = posix_to_ordinal_era(posix_in[i]);
+    }
+}
+
+KISS_POSIX_TIME_INLINE void calendar_step_init(kiss_time_t const n_seconds, kiss_calendar_step *const step_out){
+    kiss_time_t const days = n_seconds / SECS_PER_DAY;
+    step_out->n_seconds = n_seconds;
+    step_out->days = (days <= CALENDAR_STEP_MAX_DAYS) ? static_cast<uint32_t>(days) : CALENDAR_STEP_MAX_DAYS + 1;
+    step_out->hours = static_cast<uint8_t>( n_seconds / SECS_PER_HOUR % 24 );
+    step_out->minutes = static_cast<uint8_t>( n_seconds / SECS_PER_MIN % 60 );
+    step_out->seconds = static_cast<uint8_t>( n_seconds % 60 );
+}
+
+// long steps: through posix time, with the wide conversion so that going past the end of kiss_calendar_time is detected;
+// calendar_in and calendar_out can be the same calendar
+static bool calendar_advance_long(kiss_calendar_time const *const calendar_in, kiss_calendar_step const *const step,
+                                  kiss_calendar_time *const calendar_out){
+    kiss_time_t const posix = calendar_to_posix(calendar_in);
+    if (step->n_seconds > UINT64_MAX - posix){
+        return false;
+    }
+
+    kiss_wide_calendar_time wide_calendar;
+    posix_to_wide_calendar_era(posix + step->n_seconds, &wide_calendar);
+    if (wide_calendar.year > UINT16_MAX){
+        return false;
+    }
+
+    calendar_out->year = static_cast<uint16_t>(wide_calendar.year);
+    calendar_out->month = wide_calendar.month;
+    calendar_out->day = wide_calendar.day;
+    calendar_out->hour = wide_calendar.hour;
+    calendar_out->minute = wide_calendar.minute;
+    calendar_out->second = wide_calendar.second;
+    return true;
+}
+
+// short steps: field by field, with carries. The calendar is passed and returned by value, i.e. in a register, so
+// that stepping a series does not go through memory at each step; month is 0 in the result if it would be after the
+// end of kiss_calendar_time
+static kiss_calendar_time calendar_advance_short(kiss_calendar_time const calendar_in, kiss_calendar_step const *const step){
+    // the time of the day, with at most one carry per field
+    uint32_t second = static_cast<uint32_t>(calendar_in.second) + step->seconds;
+    uint32_t minute = static_cast<uint32_t>(calendar_in.minute) + step->minutes;
+    uint32_t hour = static_cast<uint32_t>(calendar_in.hour) + step->hours;
+    uint32_t day = static_cast<uint32_t>(calendar_in.day) + step->days;
+
+    if (second >= 60){
+        second -= 60;
+        minute++;
+    }
+    if (minute >= 60){
+        minute -= 60;
+        hour++;
+    }
+    if (hour >= 24){
+        hour -= 24;
+        day++;
+    }
+
+    // then walk over the months; no month is shorter than 28 days, so the most common case needs no leap year check
+    uint8_t month = calendar_in.month;
+    uint32_t year = calendar_in.year;
+    uint8_t const *days_per_month = days_per_month_normal;
+    if (day > 28){
+        days_per_month = is_leap_year(calendar_in.year) ? days_per_month_leap : days_per_month_normal;
+    }
 
-    if (
-            (calendar_in->month >= 1) &&
-            (calendar_in->month <= 12) &&
-            (calendar_in->day >= 1) &&
-            (calendar_in->day <= month_length) &&
-            (calendar_in->hour <= 23) &&
-            (calendar_in->minute <= 59) &&
-            (calendar_in->second <= 59)
-        ){
-        return true;
+    while (day > days_per_month[month - 1]){
+        day -= days_per_month[month - 1];
+        if (month < 12){
+            month++;
+        }
+        else{
+            month = 1;
+            year++;
+            if (year > UINT16_MAX){
+                return kiss_calendar_time {calendar_in.year, 0, 0, 0, 0, 0};
+            }
+            days_per_month = is_leap_year(static_cast<uint16_t>(year)) ? days_per_month_leap : days_per_month_normal;
+        }
     }
-    else {
+
+    return kiss_calendar_time {static_cast<uint16_t>(year), month, static_cast<uint8_t>(day),
+                               static_cast<uint8_t>(hour), static_cast<uint8_t>(minute), static_cast<uint8_t>(second)};
+}
+
+KISS_POSIX_TIME_INLINE bool calendar_advance(kiss_calendar_time *const calendar_in_out, kiss_calendar_step const *const step){
+    if (step->days > CALENDAR_STEP_MAX_DAYS){
+        return calendar_advance_long(calendar_in_out, step, calendar_in_out);
+    }
+    kiss_calendar_time const result = calendar_advance_short(*calendar_in_out, step);
+    if (result.month == 0){
         return false;
     }
+    *calendar_in_out = result;
+    return true;
 }
 
-#if USE_JR_IMPLEMENTATION
+KISS_POSIX_TIME_INLINE bool calendar_advance_seconds(kiss_calendar_time *const calendar_in_out, kiss_time_t const n_seconds){
+    kiss_calendar_step step;
+    calendar_step_init(n_seconds, &step);
+    return calendar_advance(calendar_in_out, &step);
+}
+
+KISS_POSIX_TIME_INLINE size_t calendar_fill_steps(kiss_calendar_time const *const calendar_start, kiss_time_t const n_seconds,
+                                                  kiss_calendar_time *const calendar_out, size_t const n_entries){
+    if (n_entries == 0){
+        return 0;
+    }
+
+    kiss_calendar_step step;
+    calendar_step_init(n_seconds, &step);
+
+    calendar_out[0] = *calendar_start;
+
+    if (step.days > CALENDAR_STEP_MAX_DAYS){
+        for (size_t i=1; i<n_entries; i++){
+            if (!calendar_advance_long(&calendar_out[i-1], &step, &calendar_out[i])){
+                return i;
+            }
+        }
+        return n_entries;
+    }
+
+    // step a local calendar, that stays in registers, rather than reading back the previous output
+    kiss_calendar_time working_calendar = *calendar_start;
+    for (size_t i=1; i<n_entries; i++){
+        working_calendar = calendar_advance_short(working_calendar, &step);
+        if (working_calendar.month == 0){
+            return i;
+        }
+        calendar_out[i] = working_calendar;
+    }
+
+    return n_entries;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////
+// the backends of calendar_to_posix and posix_to_calendar
 
     // my own readable (according to me :) ) implementations
     
-    kiss_time_t calendar_to_posix(kiss_calendar_time const * const calendar_in){
+    KISS_POSIX_TIME_INLINE kiss_time_t calendar_to_posix_jr(kiss_calendar_time const * const calendar_in){
         kiss_time_t seconds;
 
         ////////////////////////////////////////////////////////////
         // start by computing seconds from EPOCH_START until 1 jan 00:00:00 of the given year
         // this is the number of days times seconds per day for the years until the previous year, included
-        uint16_t year_minus_1 = static_cast<uint16_t>(calendar_in->year - 1);
-        seconds = SECS_PER_DAY * static_cast<kiss_time_t>(
-            year_minus_1 * 365 + year_minus_1 / 4 - year_minus_1 / 100 + year_minus_1 / 400
-            - 719162  // the value we would get for the expression starting at year 0 instead of 1970
-        );
+        seconds = SECS_PER_DAY * days_to_start_of_year(calendar_in->year);
         
         ////////////////////////////////////////////////////////////
         // add all the days for the months fully elapsed in this year, months start from 1
@@ -93,7 +449,7 @@ bool calendar_is_valid(kiss_calendar_time const *const calendar_in){
         return seconds;
     }
 
-    void posix_to_calendar(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out)
+    KISS_POSIX_TIME_INLINE void posix_to_calendar_jr(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out)
     {
         kiss_time_t time; // time has a "changing unit" in the following, secs -> mins -> hrs -> days...
 
@@ -130,6 +486,7 @@ bool calendar_is_valid(kiss_calendar_time const *const calendar_in){
         // count cumulative number of days per year until we overshoot the number of days we look for
         while (true){
             nbr_days_in_current_year = is_leap_year(year) ? days_leap_year : days_normal_year;
+            KISS_INSTRUMENT_COUNT(KISS_COUNT_YEAR_LOOP_ITERATIONS, 1);
             if (nbr_days_in_current_year <= time){
                 year = static_cast<uint16_t>(year + 1);
                 time -= nbr_days_in_current_year;
@@ -153,6 +510,9 @@ bool calendar_is_valid(kiss_calendar_time const *const calendar_in){
         }
 
         // find out which month we are in, and how many days are left
+        // the loop always finds the month; the default is only there so that, when this is inlined (header-only
+        // mode), the compiler does not warn that the month may be left uninitialized
+        calendar_out->month = 12;
         for (uint8_t month=1; month<=12; month++)
         {
             if (time < (*cumulative_days_per_month)[month]){
@@ -167,13 +527,11 @@ bool calendar_is_valid(kiss_calendar_time const *const calendar_in){
         calendar_out->day = static_cast<uint8_t>( time + 1 );    // day of month, starts at 1 not 0
     }
 
-#else
-
     // the Oryx implementations
 
     // calendar to posix, with modulo magics, though relatively similar to mine...
     // about the same speed as mine, and mince is easier to understand, so keep mine.
-    kiss_time_t calendar_to_posix(kiss_calendar_time const * const calendar_in) {
+    KISS_POSIX_TIME_INLINE kiss_time_t calendar_to_posix_oryx(kiss_calendar_time const * const calendar_in) {
     int y;
     int m;
     int d;
@@ -212,7 +570,7 @@ bool calendar_is_valid(kiss_calendar_time const *const calendar_in){
     // these expressions in the first place ^^ :)
     // funnily, this is slightly slower than my implementation above on my computer (though not clear how relevant for a MCU),
     // so keep my implementation :) . But this passes all tests, so this seems to be correct!
-    void posix_to_calendar(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out){
+    KISS_POSIX_TIME_INLINE void posix_to_calendar_oryx(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out){
     uint32_t a;
     uint32_t b;
     uint32_t c;
@@ -255,4 +613,79 @@ bool calendar_is_valid(kiss_calendar_time const *const calendar_in){
     calendar_out->day = static_cast<uint8_t>(f);
     }
 
+    // the era based implementations, i.e. the same algorithms as for the wide calendars: no loop and no table,
+    // and the same time whatever the year
+    KISS_POSIX_TIME_INLINE kiss_time_t calendar_to_posix_era(kiss_calendar_time const *const calendar_in){
+        uint64_t const year = calendar_in->year - (calendar_in->month <= 2 ? 1u : 0u);
+        uint64_t const era = year / 400;
+        uint64_t const year_of_era = year - era * 400;
+        uint64_t const day_of_year = (153 * (calendar_in->month > 2 ? calendar_in->month - 3u : calendar_in->month + 9u) + 2) / 5
+                                     + calendar_in->day - 1;
+        uint64_t const day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+        uint64_t const days = era * 146097 + day_of_era - DAYS_FROM_0000_03_01_TO_EPOCH;
+
+        return days * SECS_PER_DAY + calendar_in->hour * SECS_PER_HOUR + calendar_in->minute * SECS_PER_MIN + calendar_in->second;
+    }
+
+    KISS_POSIX_TIME_INLINE void posix_to_calendar_era(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out){
+        kiss_wide_calendar_time wide_calendar;
+        posix_to_wide_calendar_era(posix_in, &wide_calendar);
+
+        calendar_out->year = static_cast<uint16_t>(wide_calendar.year);
+        calendar_out->month = wide_calendar.month;
+        calendar_out->day = wide_calendar.day;
+        calendar_out->hour = wide_calendar.hour;
+        calendar_out->minute = wide_calendar.minute;
+        calendar_out->second = wide_calendar.second;
+    }
+
+// the default backends, chosen at compile time; see kiss_posix_time_backends for choosing at run time
+static kiss_time_t calendar_to_posix_default(kiss_calendar_time const *const calendar_in){
+    #if USE_JR_IMPLEMENTATION
+        return calendar_to_posix_jr(calendar_in);
+    #else
+        return calendar_to_posix_oryx(calendar_in);
+    #endif
+}
+
+static void posix_to_calendar_default(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out){
+    #if USE_JR_IMPLEMENTATION
+        posix_to_calendar_jr(posix_in, calendar_out);
+    #else
+        posix_to_calendar_oryx(posix_in, calendar_out);
+    #endif
+}
+
+KISS_POSIX_TIME_INLINE kiss_time_t calendar_to_posix(kiss_calendar_time const *const calendar_in){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_CALENDAR_TO_POSIX, 1);
+    KISS_INSTRUMENT_TIMER_START(instrumentation_start);
+    kiss_time_t const posix = calendar_to_posix_default(calendar_in);
+    KISS_INSTRUMENT_TIMER_STOP(KISS_TIMER_CALENDAR_TO_POSIX, instrumentation_start);
+    return posix;
+}
+
+KISS_POSIX_TIME_INLINE void posix_to_calendar(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_POSIX_TO_CALENDAR, 1);
+    KISS_INSTRUMENT_TIMER_START(instrumentation_start);
+    posix_to_calendar_default(posix_in, calendar_out);
+    KISS_INSTRUMENT_TIMER_STOP(KISS_TIMER_POSIX_TO_CALENDAR, instrumentation_start);
+}
+
+// the batch conversions are counted once per call, not once per entry
+KISS_POSIX_TIME_INLINE void calendar_to_posix_batch(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out, size_t const n_entries){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_CALLS, 1);
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_ENTRIES, n_entries);
+    for (size_t i=0; i<n_entries; i++){
+        posix_out[i] = calendar_to_posix_default(&calendar_in[i]);
+    }
+}
+
+KISS_POSIX_TIME_INLINE void posix_to_calendar_batch(kiss_time_t const *const posix_in, kiss_calendar_time *const calendar_out, size_t const n_entries){
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_CALLS, 1);
+    KISS_INSTRUMENT_COUNT(KISS_COUNT_BATCH_ENTRIES, n_entries);
+    for (size_t i=0; i<n_entries; i++){
+        posix_to_calendar_default(posix_in[i], &calendar_out[i]);
+    }
+}
+
 #endif
@@ -13,6 +13,8 @@
   #include <stddef.h>
 #endif
 
+#include "kiss_posix_time_config.hpp"
+
 /*
 
 The aim of this library is to provide a self contained, minimalistic way of performing conversions
@@ -48,8 +50,10 @@ https://github.com/Oryx-Embedded/Common/blob/master/date_time.c
 
 Note that you can choose between my "easy to understand" implementation
 and the more dark magics Oryx implementation by changing the USE_JR_IMPLEMENTATION
-switch in the cpp file. In practice, does not seem to make any meaningful performance
+switch in kiss_posix_time_config.hpp. In practice, does not seem to make any meaningful performance
 difference, but my implementation is more understandable...
+All the implementations are also available under their own names (see the end of this file), and
+kiss_posix_time_backends can time them on the current host and use the fastest one.
 
 */
 
@@ -78,6 +82,49 @@ struct kiss_calendar_time
     uint8_t second;
 };
 
+// same as kiss_calendar_time, but with a year that is not limited to 65535; a kiss_time_t goes up to
+// year 584554051223, i.e. much further than what a uint16_t year can represent
+struct kiss_wide_calendar_time
+{
+    int64_t year;
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+};
+
+// ordinal date, i.e. year and day of the year, as in the ISO 8601 YYYY-DDD form
+// day_of_year is in "natural" convention: 1 is 1st january, ..., 365 (366 in leap years) is 31st december
+struct kiss_ordinal_date
+{
+    uint16_t year;
+    uint16_t day_of_year;
+};
+
+// result of the checked conversions: either success, or the first field that is not valid
+enum kiss_conversion_status : uint8_t
+{
+    KISS_CONVERSION_OK = 0,
+    KISS_CONVERSION_INVALID_YEAR,    // year is before EPOCH_START
+    KISS_CONVERSION_INVALID_MONTH,
+    KISS_CONVERSION_INVALID_DAY,
+    KISS_CONVERSION_INVALID_HOUR,
+    KISS_CONVERSION_INVALID_MINUTE,
+    KISS_CONVERSION_INVALID_SECOND
+};
+
+// a number of seconds, split once into days and time of day, to advance calendars repeatedly by the same amount
+// with calendar_advance; fill with calendar_step_init
+struct kiss_calendar_step
+{
+    kiss_time_t n_seconds;
+    uint32_t days;          // more than CALENDAR_STEP_MAX_DAYS if the step is too long to walk over the months
+    uint8_t hours;
+    uint8_t minutes;
+    uint8_t seconds;
+};
+
 //////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////
 // constants
@@ -89,6 +136,15 @@ static constexpr kiss_time_t SECS_PER_YEAR = 31536000;
 
 static constexpr uint16_t EPOCH_START = 1970;
 
+// the last posix time that fits in a kiss_calendar_time, 65535-12-31T23:59:59
+static constexpr kiss_time_t LAST_POSIX_IN_CALENDAR_TIME = 2005949145599;
+// the first posix time that does not have a 4 digits year, 10000-01-01T00:00:00
+static constexpr kiss_time_t FIRST_POSIX_OF_YEAR_10000 = 253402300800;
+
+// Julian Day Number and Modified Julian Day of 1970-01-01
+static constexpr kiss_time_t JULIAN_DAY_NUMBER_OF_EPOCH   = 2440588;
+static constexpr kiss_time_t MODIFIED_JULIAN_DAY_OF_EPOCH = 40587;
+
 static constexpr uint32_t days_normal_year = 365;
 static constexpr uint32_t days_leap_year   = 366;
 
@@ -102,6 +158,9 @@ static constexpr uint16_t cumulative_days_per_month_normal[] =
 static constexpr uint16_t cumulative_days_per_month_leap[] =
     {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366};
 
+// longest step, in days, that calendar_advance applies by walking over the months; longer steps go through posix time
+static constexpr uint32_t CALENDAR_STEP_MAX_DAYS = 366;
+
 //////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////
 // functions
@@ -120,10 +179,91 @@ kiss_time_t calendar_to_posix(kiss_calendar_time const *const calendar_in);
 
 // given a posix time, compute the corresponding calendar_time
 // note that kiss_calendar_time struct follows a few specific conventions,
-// see above; the calendar out will always be valid.
+// see above; the calendar out will always be valid, as long as posix_in is before year 65536 (use
+// posix_to_wide_calendar for later times).
 void posix_to_calendar(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out);
 
 // is the current calendar a valid calendar entry?
+// any calendar_in can be checked, including ones with out of range fields
 bool calendar_is_valid(kiss_calendar_time const *const calendar_in);
 
+// check n_entries calendars at once: bit i % 8 of valid_mask_out[i / 8] is set if calendar_in[i] is valid,
+// i.e. valid_mask_out must have room for (n_entries + 7) / 8 bytes
+// return the number of valid calendars
+size_t calendar_is_valid_batch(kiss_calendar_time const *const calendar_in, size_t const n_entries, uint8_t *const valid_mask_out);
+
+// same as calendar_to_posix, but check calendar_in while converting it, so that there is no need to call
+// calendar_is_valid first; posix_out is only written to if the conversion is successful
+kiss_conversion_status calendar_to_posix_checked(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out);
+
+// checked conversion of n_entries calendars at once: bit i % 8 of valid_mask_out[i / 8] is set if calendar_in[i]
+// is valid, i.e. valid_mask_out must have room for (n_entries + 7) / 8 bytes; posix_out[i] is 0 for invalid calendars
+// return the number of valid calendars
+size_t calendar_to_posix_checked_batch(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out,
+                                       size_t const n_entries, uint8_t *const valid_mask_out);
+
+// conversions for kiss_wide_calendar_time, valid over the full range of kiss_time_t; these work on whole 400 years
+// eras (the Gregorian calendar repeats every 400 years) and take the same time whatever the year
+void posix_to_wide_calendar(kiss_time_t const posix_in, kiss_wide_calendar_time *const calendar_out);
+// calendar_in must be valid; return true if success, false if the date is before EPOCH_START or after the end of kiss_time_t
+bool wide_calendar_to_posix(kiss_wide_calendar_time const *const calendar_in, kiss_time_t *const posix_out);
+
+// day numbers, directly from / to posix time, without going through the months:
+// - the Julian Day Number (JDN) of a date, i.e. the number of the Julian day that starts at noon UTC on this date; the
+//   Julian Date of a posix time is its JDN - 0.5 + (posix_in % SECS_PER_DAY) / SECS_PER_DAY
+// - the Modified Julian Day (MJD), that starts at midnight UTC; the Modified Julian Date of a posix time is its
+//   MJD + (posix_in % SECS_PER_DAY) / SECS_PER_DAY
+// the conversions to posix time give midnight UTC of the day; return true if success, false if the day is before
+// 1970-01-01 or after the end of kiss_time_t (then, posix_out is not written to)
+kiss_time_t posix_to_julian_day_number(kiss_time_t const posix_in);
+bool julian_day_number_to_posix(kiss_time_t const julian_day_number_in, kiss_time_t *const posix_out);
+kiss_time_t posix_to_modified_julian_day(kiss_time_t const posix_in);
+bool modified_julian_day_to_posix(kiss_time_t const modified_julian_day_in, kiss_time_t *const posix_out);
+
+// ordinal dates, without any month decoding nor any loop; as posix_to_calendar, posix_in must be before year 65536
+// ordinal_to_posix gives midnight UTC of the day; return true if success, false if ordinal_in is not valid or before
+// EPOCH_START (then, posix_out is not written to)
+void posix_to_ordinal(kiss_time_t const posix_in, kiss_ordinal_date *const ordinal_out);
+bool ordinal_to_posix(kiss_ordinal_date const *const ordinal_in, kiss_time_t *const posix_out);
+
+// batch versions of the day numbers conversions, over arrays of n_entries entries
+void posix_to_julian_day_number_batch(kiss_time_t const *const posix_in, kiss_time_t *const julian_day_number_out, size_t const n_entries);
+void posix_to_modified_julian_day_batch(kiss_time_t const *const posix_in, kiss_time_t *const modified_julian_day_out, size_t const n_entries);
+void posix_to_ordinal_batch(kiss_time_t const *const posix_in, kiss_ordinal_date *const ordinal_out, size_t const n_entries);
+
+// advance a valid calendar by a number of seconds, in place, with the same result as converting it to posix time,
+// adding the seconds, and converting back; but the fields are added with carries, so that for steps of up to
+// CALENDAR_STEP_MAX_DAYS, this is a few adds and compares (and a leap year check when the year changes).
+// return true if success, false if the result would be after the end of kiss_calendar_time (then, nothing is changed)
+void calendar_step_init(kiss_time_t const n_seconds, kiss_calendar_step *const step_out);
+bool calendar_advance(kiss_calendar_time *const calendar_in_out, kiss_calendar_step const *const step);
+bool calendar_advance_seconds(kiss_calendar_time *const calendar_in_out, kiss_time_t const n_seconds);
+
+// fill calendar_out with calendar_start, calendar_start + n_seconds, calendar_start + 2 * n_seconds, etc, i.e. a
+// fixed cadence series, without any conversion from posix time
+// return the number of entries filled, that is less than n_entries only if the series goes after the end of kiss_calendar_time
+size_t calendar_fill_steps(kiss_calendar_time const *const calendar_start, kiss_time_t const n_seconds,
+                           kiss_calendar_time *const calendar_out, size_t const n_entries);
+
+// batch versions of the conversions above, over arrays of n_entries entries
+void calendar_to_posix_batch(kiss_calendar_time const *const calendar_in, kiss_time_t *const posix_out, size_t const n_entries);
+void posix_to_calendar_batch(kiss_time_t const *const posix_in, kiss_calendar_time *const calendar_out, size_t const n_entries);
+
+// the different implementations (backends) of calendar_to_posix and posix_to_calendar; calendar_to_posix and
+// posix_to_calendar use the jr or the oryx ones depending on USE_JR_IMPLEMENTATION, and kiss_posix_time_backends
+// can pick the fastest one on the current host at run time. All give the same results over the range of kiss_calendar_time.
+// - jr: my implementation, with tables of cumulative days per month, and a loop over the last few years
+// - oryx: the Oryx RTOS implementation, all arithmetics and no table
+// - era: the same algorithm as the wide calendar conversions, on 400 years eras, no loop and no table
+kiss_time_t calendar_to_posix_jr(kiss_calendar_time const *const calendar_in);
+void posix_to_calendar_jr(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out);
+kiss_time_t calendar_to_posix_oryx(kiss_calendar_time const *const calendar_in);
+void posix_to_calendar_oryx(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out);
+kiss_time_t calendar_to_posix_era(kiss_calendar_time const *const calendar_in);
+void posix_to_calendar_era(kiss_time_t const posix_in, kiss_calendar_time *const calendar_out);
+
+#ifdef KISS_POSIX_TIME_HEADER_ONLY
+  #include "kiss_posix_time_utils.cpp"
+#endif
+
 #endif
@@ -0,0 +1,139 @@
+/* check that the C API can be used from C: compiled as C99, and linked with the library */
+
+#include "kiss_posix_time_c_api.h"
+
+#include <stdio.h>
+#include <string.h>
+
+int main(void){
+    kiss_calendar_time const calendar = {2021, 2, 14, 16, 32, 4};
+    kiss_calendar_time calendar_out;
+    kiss_time_t posix;
+    char buffer[40];
+
+    if (kiss_calendar_to_posix_checked(&calendar, &posix) != KISS_CONVERSION_OK || posix != 1613320324){
+        printf("C API check failed: kiss_calendar_to_posix_checked\n");
+        return 1;
+    }
+
+    kiss_posix_to_calendar(posix, &calendar_out);
+    if (calendar_out.year != calendar.year || calendar_out.month != calendar.month || calendar_out.day != calendar.day
+        || calendar_out.hour != calendar.hour || calendar_out.minute != calendar.minute || calendar_out.second != calendar.second){
+        printf("C API check failed: kiss_posix_to_calendar\n");
+        return 1;
+    }
+
+    if (!kiss_print_iso_posix(posix, buffer, 20) || strcmp(buffer, "2021-02-14T16:32:04") != 0){
+        printf("C API check failed: kiss_print_iso_posix\n");
+        return 1;
+    }
+
+    /* day numbers and ordinal dates, one by one and in batches */
+    kiss_ordinal_date ordinal;
+    kiss_posix_to_ordinal(posix, &ordinal);
+    if (kiss_posix_to_julian_day_number(posix) != 2459260 || kiss_posix_to_modified_julian_day(posix) != 59259
+        || ordinal.year != 2021 || ordinal.day_of_year != 45){
+        printf("C API check failed: day numbers and ordinal dates\n");
+        return 1;
+    }
+
+    kiss_time_t day_posix;
+    if (!kiss_julian_day_number_to_posix(2459260, &day_posix) || day_posix != 1613260800
+        || !kiss_modified_julian_day_to_posix(59259, &day_posix) || day_posix != 1613260800
+        || !kiss_ordinal_to_posix(&ordinal, &day_posix) || day_posix != 1613260800
+        || kiss_julian_day_number_to_posix(0, &day_posix)){
+        printf("C API check failed: day numbers and ordinal dates to posix\n");
+        return 1;
+    }
+
+    kiss_time_t const posix_batch[2] = {0, 1613320324};
+    kiss_time_t day_numbers[2];
+    kiss_ordinal_date ordinals[2];
+    kiss_posix_to_julian_day_number_batch(posix_batch, day_numbers, 2);
+    kiss_posix_to_ordinal_batch(posix_batch, ordinals, 2);
+    if (day_numbers[0] != 2440588 || day_numbers[1] != 2459260 || ordinals[0].day_of_year != 1 || ordinals[1].day_of_year != 45){
+        printf("C API check failed: day numbers and ordinal dates batches\n");
+        return 1;
+    }
+    kiss_posix_to_modified_julian_day_batch(posix_batch, day_numbers, 2);
+    if (day_numbers[0] != 40587 || day_numbers[1] != 59259){
+        printf("C API check failed: kiss_posix_to_modified_julian_day_batch\n");
+        return 1;
+    }
+
+    /* RFC 3339 */
+    kiss_rfc3339_options const options = {3, 60};
+    if (kiss_rfc3339_size(&options) != 29 || kiss_print_rfc3339(posix, 125000000, &options, buffer, 40) != 29
+        || strcmp(buffer, "2021-02-14T17:32:04.125+01:00") != 0){
+        printf("C API check failed: kiss_print_rfc3339\n");
+        return 1;
+    }
+
+    /* decimal epoch times */
+    kiss_time_t parsed;
+    uint16_t milliseconds;
+    if (!kiss_parse_epoch_posix("1613320324", 10, &parsed) || parsed != posix
+        || !kiss_parse_epoch_calendar("1613320324", 10, &calendar_out) || calendar_out.day != 14
+        || !kiss_parse_epoch_milliseconds("1613320324125", 13, &parsed, &milliseconds) || parsed != posix || milliseconds != 125
+        || kiss_parse_epoch_posix("16133x0324", 10, &parsed)){
+        printf("C API check failed: kiss_parse_epoch\n");
+        return 1;
+    }
+
+    char const lines[] = "1613320324\nnot a time\n0\n";
+    kiss_time_t posix_lines[4];
+    kiss_calendar_time calendar_lines[4];
+    uint8_t valid_mask;
+    size_t n_bytes;
+    if (kiss_parse_epoch_lines_posix(lines, sizeof(lines) - 1, posix_lines, &valid_mask, 4, &n_bytes) != 3 || valid_mask != 5
+        || posix_lines[0] != posix || n_bytes != sizeof(lines) - 1
+        || kiss_parse_epoch_lines_calendar(lines, sizeof(lines) - 1, calendar_lines, &valid_mask, 4, &n_bytes) != 3 || valid_mask != 5
+        || calendar_lines[2].year != 1970){
+        printf("C API check failed: kiss_parse_epoch_lines\n");
+        return 1;
+    }
+
+    if (kiss_print_epoch_posix(posix, buffer, 40) != 10 || strcmp(buffer, "1613320324") != 0
+        || kiss_print_epoch_calendar(&calendar, buffer, 40) != 10 || strcmp(buffer, "1613320324") != 0
+        || kiss_print_epoch_milliseconds(posix, 7, buffer, 40) != 13 || strcmp(buffer, "1613320324007") != 0){
+        printf("C API check failed: kiss_print_epoch\n");
+        return 1;
+    }
+
+    /* the structs mirrored for C: calendar steps, arenas, compiled patterns, packed calendars */
+    kiss_calendar_step step;
+    kiss_calendar_time stepped = calendar;
+    kiss_calendar_step_init(86400, &step);
+    if (!kiss_calendar_advance(&stepped, &step) || stepped.day != 15 || kiss_calendar_to_posix(&stepped) != posix + 86400){
+        printf("C API check failed: kiss_calendar_advance\n");
+        return 1;
+    }
+
+    char memory[64];
+    kiss_text_arena arena;
+    kiss_text_view views[2];
+    kiss_text_arena_init(&arena, memory, sizeof(memory));
+    if (kiss_print_iso_arena_posix(posix_batch, 2, &arena, views) != 2 || views[1].length != 19
+        || memcmp(memory + views[1].offset, "2021-02-14T16:32:04", 19) != 0){
+        printf("C API check failed: kiss_print_iso_arena_posix\n");
+        return 1;
+    }
+
+    kiss_format_program program;
+    if (!kiss_format_compile("%a, %d %b %Y %H:%M:%S GMT", &program)
+        || kiss_format_print_posix(&program, posix, buffer, 40) != 29 || strcmp(buffer, "Sun, 14 Feb 2021 16:32:04 GMT") != 0
+        || !kiss_format_parse(&program, buffer, 29, &parsed) || parsed != posix){
+        printf("C API check failed: kiss_format\n");
+        return 1;
+    }
+
+    uint8_t packed_bytes[KISS_PACKED_CALENDAR_SIZE];
+    kiss_packed_calendar_store(kiss_posix_to_packed_calendar(posix), packed_bytes);
+    if (kiss_packed_calendar_to_posix(kiss_packed_calendar_load(packed_bytes)) != posix){
+        printf("C API check failed: packed calendars\n");
+        return 1;
+    }
+
+    printf("C API check passed\n");
+    return 0;
+}
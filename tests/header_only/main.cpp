@@ -0,0 +1,25 @@
+// check of the header-only mode: two translation units include the whole library with KISS_POSIX_TIME_HEADER_ONLY
+// defined, and are linked together without any of the .cpp files of the src folder
+
+#include "../../src/kiss_posix_time.hpp"
+
+#include <stdio.h>
+
+kiss_time_t second_translation_unit_roundtrip(kiss_time_t const posix_in);
+
+int main(){
+    kiss_calendar_time const calendar {2021, 2, 14, 16, 32, 4};
+    kiss_time_t const posix = calendar_to_posix(&calendar);
+
+    char buffer[20];
+    print_iso(posix, buffer, 20);
+    printf("%s\n", buffer);
+
+    if (second_translation_unit_roundtrip(posix) != posix || kiss_calendar_to_posix(&calendar) != posix){
+        printf("header-only check failed\n");
+        return 1;
+    }
+
+    printf("header-only check passed\n");
+    return 0;
+}
@@ -0,0 +1,7 @@
+#include "../../src/kiss_posix_time.hpp"
+
+kiss_time_t second_translation_unit_roundtrip(kiss_time_t const posix_in){
+    kiss_calendar_time calendar;
+    posix_to_calendar(posix_in, &calendar);
+    return calendar_to_posix(&calendar);
+}
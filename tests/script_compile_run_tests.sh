@@ -13,7 +13,29 @@ echo " "
 echo "--------------------"
 echo "compile all tests"
 
-g++ $WFLAGS -o test_suite.out main.cpp test*.cpp ../src/kiss_posix_time_utils.cpp ../src/kiss_posix_time_extras.cpp
+g++ $WFLAGS -o test_suite.out main.cpp test*.cpp ../src/kiss_posix_time_utils.cpp ../src/kiss_posix_time_extras.cpp ../src/kiss_posix_time_schedule.cpp ../src/kiss_posix_time_compression.cpp ../src/kiss_posix_time_series.cpp ../src/kiss_posix_time_c_api.cpp ../src/kiss_posix_time_backends.cpp ../src/kiss_posix_time_instrumentation.cpp ../src/kiss_posix_time_clock.cpp ../src/kiss_posix_time_format.cpp ../src/kiss_posix_time_decimal.cpp -pthread
+
+echo " "
+echo "--------------------"
+echo "check that the C API header is valid C"
+
+gcc -std=c99 -pedantic -Wall -Wextra -Werror -fsyntax-only -x c ../src/kiss_posix_time_c_api.h
+
+echo " "
+echo "--------------------"
+echo "check the header-only mode"
+
+g++ $WFLAGS -DKISS_POSIX_TIME_HEADER_ONLY -o header_only.out header_only/main.cpp header_only/second_translation_unit.cpp
+./header_only.out
+rm ./header_only.out
+
+echo " "
+echo "--------------------"
+echo "check the instrumentation"
+
+g++ $WFLAGS -DKISS_POSIX_TIME_HEADER_ONLY -DKISS_POSIX_TIME_INSTRUMENTATION -pthread -o instrumentation.out main.cpp test_posix_time_instrumentation.cpp
+./instrumentation.out
+rm ./instrumentation.out
 
 echo " "
 echo "--------------------"
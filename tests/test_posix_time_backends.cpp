@@ -0,0 +1,94 @@
+#include "catch.hpp"
+#include "../src/kiss_posix_time_utils.hpp"
+#include "../src/kiss_posix_time_backends.hpp"
+#include <stdlib.h>
+#include <string.h>
+
+// field by field, as the padding of kiss_calendar_time is not initialized
+static bool same_calendar(kiss_calendar_time const &first, kiss_calendar_time const &second){
+    return first.year == second.year && first.month == second.month && first.day == second.day
+           && first.hour == second.hour && first.minute == second.minute && first.second == second.second;
+}
+
+TEST_CASE("backends_agree"){
+    // all the backends give the same results, over the whole range of kiss_calendar_time
+    kiss_time_t const last_posix = 2005949145599;  // 65535-12-31T23:59:59
+    kiss_time_t const posix_values[] = {0, 1, 86399, 86400, 951782400, 951868799, 4107542400, last_posix};
+
+    auto check = [](kiss_time_t const posix){
+        kiss_calendar_time jr;
+        kiss_calendar_time oryx;
+        kiss_calendar_time era;
+        posix_to_calendar_jr(posix, &jr);
+        posix_to_calendar_oryx(posix, &oryx);
+        posix_to_calendar_era(posix, &era);
+        REQUIRE( same_calendar(jr, oryx) );
+        REQUIRE( same_calendar(jr, era) );
+
+        REQUIRE( calendar_to_posix_jr(&jr) == posix );
+        REQUIRE( calendar_to_posix_oryx(&jr) == posix );
+        REQUIRE( calendar_to_posix_era(&jr) == posix );
+    };
+
+    for (kiss_time_t const posix : posix_values){
+        check(posix);
+    }
+    for (size_t i=0; i<100000; i++){
+        check((static_cast<kiss_time_t>(rand()) << 10 | static_cast<kiss_time_t>(rand() % 1024)) % (last_posix + 1));
+    }
+}
+
+TEST_CASE("backends_select_and_report"){
+    kiss_backend_report report;
+
+    REQUIRE( !backend_select(KISS_N_BACKENDS, KISS_BACKEND_JR) );
+    REQUIRE( backend_select(KISS_BACKEND_ERA, KISS_BACKEND_ORYX) );
+    backend_report(&report);
+    REQUIRE( report.posix_to_calendar_backend == KISS_BACKEND_ERA );
+    REQUIRE( report.calendar_to_posix_backend == KISS_BACKEND_ORYX );
+    REQUIRE( !report.calibrated );
+
+    REQUIRE( strcmp(backend_name(KISS_BACKEND_JR), "jr") == 0 );
+    REQUIRE( strcmp(backend_name(KISS_BACKEND_ORYX), "oryx") == 0 );
+    REQUIRE( strcmp(backend_name(KISS_BACKEND_ERA), "era") == 0 );
+    REQUIRE( strcmp(backend_name(KISS_N_BACKENDS), "unknown") == 0 );
+
+    kiss_calendar_time const calendar {2021, 12, 6, 12, 53, 27};
+    kiss_calendar_time calendar_out;
+    REQUIRE( backend_calendar_to_posix(&calendar) == 1638795207 );
+    backend_posix_to_calendar(1638795207, &calendar_out);
+    REQUIRE( same_calendar(calendar, calendar_out) );
+}
+
+TEST_CASE("backends_calibrate"){
+    backend_calibrate(3);
+
+    kiss_backend_report report;
+    backend_report(&report);
+    REQUIRE( report.calibrated );
+    REQUIRE( report.posix_to_calendar_backend < KISS_N_BACKENDS );
+    REQUIRE( report.calendar_to_posix_backend < KISS_N_BACKENDS );
+    for (uint8_t backend=0; backend<KISS_N_BACKENDS; backend++){
+        // all backends are correct, so all get a time; the chosen ones are the fastest
+        REQUIRE( report.posix_to_calendar_ns[backend] != UINT64_MAX );
+        REQUIRE( report.calendar_to_posix_ns[backend] != UINT64_MAX );
+        REQUIRE( report.posix_to_calendar_ns[report.posix_to_calendar_backend] <= report.posix_to_calendar_ns[backend] );
+        REQUIRE( report.calendar_to_posix_ns[report.calendar_to_posix_backend] <= report.calendar_to_posix_ns[backend] );
+    }
+
+    // whatever was chosen, the batch conversions through the table give the usual results
+    kiss_time_t posix_in[100];
+    kiss_calendar_time calendars[100];
+    kiss_time_t posix_out[100];
+    for (size_t i=0; i<100; i++){
+        posix_in[i] = static_cast<kiss_time_t>(rand()) * 2;
+    }
+    backend_posix_to_calendar_batch(posix_in, calendars, 100);
+    backend_calendar_to_posix_batch(calendars, posix_out, 100);
+    for (size_t i=0; i<100; i++){
+        kiss_calendar_time expected;
+        posix_to_calendar(posix_in[i], &expected);
+        REQUIRE( same_calendar(calendars[i], expected) );
+        REQUIRE( posix_out[i] == posix_in[i] );
+    }
+}
@@ -0,0 +1,159 @@
+#include "catch.hpp"
+#include "../src/kiss_posix_time_c_api.h"
+#include <string.h>
+#include <string>
+
+TEST_CASE("c_api_forwarding"){
+    kiss_calendar_time working_calendar {2021, 12, 6, 12, 53, 27};
+    kiss_time_t working_time;
+
+    REQUIRE( kiss_is_leap_year(2000) );
+    REQUIRE( !kiss_is_leap_year(2100) );
+
+    REQUIRE( kiss_calendar_to_posix(&working_calendar) == 1638795207 );
+    REQUIRE( kiss_calendar_is_valid(&working_calendar) );
+    REQUIRE( kiss_calendar_to_posix_checked(&working_calendar, &working_time) == KISS_CONVERSION_OK );
+    REQUIRE( working_time == 1638795207 );
+
+    kiss_posix_to_calendar(951782464, &working_calendar);
+    REQUIRE( working_calendar.year == 2000 );
+    REQUIRE( working_calendar.month == 2 );
+    REQUIRE( working_calendar.day == 29 );
+
+    kiss_wide_calendar_time wide_calendar;
+    kiss_posix_to_wide_calendar(951782464, &wide_calendar);
+    REQUIRE( wide_calendar.year == 2000 );
+    REQUIRE( kiss_wide_calendar_to_posix(&wide_calendar, &working_time) );
+    REQUIRE( working_time == 951782464 );
+
+    char buffer[20];
+    REQUIRE( kiss_print_iso_posix(1638795207, buffer, 20) );
+    REQUIRE( strncmp(buffer, "2021-12-06T12:53:27", 20) == 0 );
+    REQUIRE( kiss_print_iso_calendar(&working_calendar, buffer, 20) );
+    REQUIRE( strncmp(buffer, "2000-02-29T00:01:04", 20) == 0 );
+
+    REQUIRE( kiss_day_of_week_posix(1638795207) == 1 );
+    REQUIRE( kiss_day_of_week_calendar(&working_calendar) == 2 );
+}
+
+TEST_CASE("c_api_batch"){
+    kiss_time_t const posix_in[] = {0, 951782464, 1638795207};
+    kiss_calendar_time calendars[3];
+    kiss_time_t posix_out[3];
+    uint8_t valid_mask[1];
+
+    kiss_posix_to_calendar_batch(posix_in, calendars, 3);
+    REQUIRE( kiss_calendar_is_valid_batch(calendars, 3, valid_mask) == 3 );
+    REQUIRE( valid_mask[0] == 0x07 );
+
+    kiss_calendar_to_posix_batch(calendars, posix_out, 3);
+    for (size_t i=0; i<3; i++){
+        REQUIRE( posix_out[i] == posix_in[i] );
+    }
+
+    calendars[1].month = 13;
+    REQUIRE( kiss_calendar_to_posix_checked_batch(calendars, posix_out, 3, valid_mask) == 2 );
+    REQUIRE( valid_mask[0] == 0x05 );
+    REQUIRE( posix_out[1] == 0 );
+}
+
+TEST_CASE("c_api_calendar_steps"){
+    kiss_calendar_time working_calendar {2020, 2, 28, 23, 0, 0};
+    kiss_calendar_step step;
+    kiss_calendar_step_init(2 * SECS_PER_HOUR, &step);
+    REQUIRE( kiss_calendar_advance(&working_calendar, &step) );
+    REQUIRE( working_calendar.day == 29 );
+    REQUIRE( working_calendar.hour == 1 );
+    REQUIRE( kiss_calendar_advance_seconds(&working_calendar, SECS_PER_DAY) );
+    REQUIRE( working_calendar.month == 3 );
+    REQUIRE( working_calendar.day == 1 );
+
+    kiss_calendar_time series[3];
+    REQUIRE( kiss_calendar_fill_steps(&working_calendar, SECS_PER_DAY, series, 3) == 3 );
+    REQUIRE( series[2].day == 3 );
+    REQUIRE( kiss_calendar_to_posix(&series[2]) == kiss_calendar_to_posix(&working_calendar) + 2 * SECS_PER_DAY );
+}
+
+TEST_CASE("c_api_text"){
+    char memory[128];
+    kiss_text_arena arena;
+    kiss_text_view views[2];
+    kiss_time_t const posix_in[] = {0, 1613320324};
+    kiss_calendar_time calendars[2];
+    kiss_posix_to_calendar_batch(posix_in, calendars, 2);
+
+    kiss_text_arena_init(&arena, memory, sizeof(memory));
+    REQUIRE( kiss_print_iso_arena_posix(posix_in, 2, &arena, views) == 2 );
+    REQUIRE( std::string(memory + views[1].offset, views[1].length) == "2021-02-14T16:32:04" );
+    REQUIRE( kiss_print_iso_arena_calendar(calendars, 2, &arena, views) == 2 );
+    REQUIRE( std::string(memory + views[0].offset, views[0].length) == "1970-01-01T00:00:00" );
+
+    kiss_text_arena_clear(&arena);
+    kiss_rfc3339_options const options {3, 0};
+    uint32_t const nanoseconds[] = {0, 125000000};
+    REQUIRE( kiss_print_rfc3339_arena(posix_in, nanoseconds, 2, &options, &arena, views) == 2 );
+    REQUIRE( std::string(memory + views[1].offset, views[1].length) == "2021-02-14T16:32:04.125Z" );
+    REQUIRE( kiss_print_epoch_arena_posix(posix_in, 2, &arena, views) == 2 );
+    REQUIRE( std::string(memory + views[1].offset, views[1].length) == "1613320324" );
+    REQUIRE( kiss_print_epoch_arena_calendar(calendars, 2, &arena, views) == 2 );
+    REQUIRE( std::string(memory + views[0].offset, views[0].length) == "0" );
+
+    kiss_iso_formatter formatter;
+    kiss_iso_formatter_init(&formatter);
+    REQUIRE( strcmp(kiss_iso_formatter_print(&formatter, 1613320324), "2021-02-14T16:32:04") == 0 );
+    REQUIRE( strcmp(kiss_iso_formatter_print(&formatter, 1613320325), "2021-02-14T16:32:05") == 0 );
+}
+
+TEST_CASE("c_api_format"){
+    kiss_format_program program;
+    REQUIRE( kiss_format_compile("%d/%m/%Y %H:%M:%S", &program) );
+    REQUIRE( !kiss_format_compile("%Q", &program) );
+    REQUIRE( kiss_format_compile("%d/%m/%Y %H:%M:%S", &program) );
+
+    char buffer[40];
+    kiss_calendar_time const working_calendar {2021, 2, 14, 16, 32, 4};
+    REQUIRE( kiss_format_print_posix(&program, 1613320324, buffer, 40) == 19 );
+    REQUIRE( strcmp(buffer, "14/02/2021 16:32:04") == 0 );
+    REQUIRE( kiss_format_print_calendar(&program, &working_calendar, buffer, 40) == 19 );
+    REQUIRE( strcmp(buffer, "14/02/2021 16:32:04") == 0 );
+
+    char memory[64];
+    kiss_text_arena arena;
+    kiss_text_view views[2];
+    kiss_time_t const posix_in[] = {0, 1613320324};
+    kiss_text_arena_init(&arena, memory, sizeof(memory));
+    REQUIRE( kiss_format_print_arena_posix(&program, posix_in, 2, &arena, views) == 2 );
+    REQUIRE( std::string(memory + views[0].offset, views[0].length) == "01/01/1970 00:00:00" );
+    REQUIRE( kiss_format_print_arena_calendar(&program, &working_calendar, 1, &arena, views) == 1 );
+    REQUIRE( std::string(memory + views[0].offset, views[0].length) == "14/02/2021 16:32:04" );
+
+    kiss_time_t working_time;
+    REQUIRE( kiss_format_parse(&program, "14/02/2021 16:32:04", 19, &working_time) );
+    REQUIRE( working_time == 1613320324 );
+    REQUIRE( !kiss_format_parse(&program, "30/02/2021 16:32:04", 19, &working_time) );
+
+    char const lines[] = "14/02/2021 16:32:04\nnot a time\n";
+    kiss_time_t posix_lines[2];
+    uint8_t valid_mask;
+    size_t n_bytes;
+    REQUIRE( kiss_format_parse_lines(&program, lines, sizeof(lines) - 1, posix_lines, &valid_mask, 2, &n_bytes) == 2 );
+    REQUIRE( valid_mask == 1 );
+    REQUIRE( posix_lines[0] == 1613320324 );
+    REQUIRE( n_bytes == sizeof(lines) - 1 );
+}
+
+TEST_CASE("c_api_packed_calendar"){
+    kiss_calendar_time working_calendar {2021, 2, 14, 16, 32, 4};
+    kiss_packed_calendar_t const packed = kiss_pack_calendar(&working_calendar);
+    REQUIRE( kiss_posix_to_packed_calendar(1613320324) == packed );
+    REQUIRE( kiss_packed_calendar_to_posix(packed) == 1613320324 );
+
+    uint8_t bytes[KISS_PACKED_CALENDAR_SIZE];
+    kiss_packed_calendar_store(packed, bytes);
+    REQUIRE( kiss_packed_calendar_load(bytes) == packed );
+
+    kiss_calendar_time unpacked;
+    kiss_unpack_calendar(packed, &unpacked);
+    REQUIRE( unpacked.year == 2021 );
+    REQUIRE( unpacked.second == 4 );
+}
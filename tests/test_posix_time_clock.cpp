@@ -0,0 +1,158 @@
+#include "catch.hpp"
+#include "../src/kiss_posix_time_clock.hpp"
+#include "../src/kiss_posix_time_extras.hpp"
+
+#include <atomic>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// a fake clock, that the tests move by hand
+static std::atomic<kiss_time_t> fake_now {0};
+
+static kiss_time_t fake_source(){
+    return fake_now.load();
+}
+
+// a fake clock that runs behind by lag seconds in the threads that set it, as if it had been set back there
+static thread_local kiss_time_t fake_lag {0};
+
+static kiss_time_t lagging_fake_source(){
+    kiss_time_t const now = fake_now.load();
+    return (now > fake_lag) ? now - fake_lag : 0;
+}
+
+// the snapshot holds the calendar and iso string of its posix time
+static bool snapshot_is_consistent(kiss_clock_snapshot const &snapshot){
+    char iso[20];
+    print_iso(snapshot.posix, iso, 20);
+    return calendar_to_posix(&snapshot.calendar) == snapshot.posix && strcmp(iso, snapshot.iso) == 0;
+}
+
+TEST_CASE("clock_cached_second"){
+    fake_now = 1638795207;
+    clock_set_source(fake_source);
+
+    kiss_clock_snapshot snapshot;
+    clock_now(&snapshot);
+    REQUIRE( snapshot.posix == 1638795207 );
+    REQUIRE( snapshot.calendar.year == 2021 );
+    REQUIRE( snapshot.calendar.month == 12 );
+    REQUIRE( snapshot.calendar.day == 6 );
+    REQUIRE( snapshot.calendar.hour == 12 );
+    REQUIRE( snapshot.calendar.minute == 53 );
+    REQUIRE( snapshot.calendar.second == 27 );
+    REQUIRE( strcmp(snapshot.iso, "2021-12-06T12:53:27") == 0 );
+
+    // from the cache
+    clock_now(&snapshot);
+    REQUIRE( snapshot.posix == 1638795207 );
+    REQUIRE( strcmp(snapshot.iso, "2021-12-06T12:53:27") == 0 );
+
+    // rollover, also of the day
+    fake_now = 1638835199;
+    clock_now(&snapshot);
+    REQUIRE( strcmp(snapshot.iso, "2021-12-06T23:59:59") == 0 );
+    fake_now = 1638835200;
+    clock_now(&snapshot);
+    REQUIRE( strcmp(snapshot.iso, "2021-12-07T00:00:00") == 0 );
+    REQUIRE( snapshot_is_consistent(snapshot) );
+
+    // the clock does not go back
+    fake_now = 1638795207;
+    clock_now(&snapshot);
+    REQUIRE( snapshot.posix == 1638835200 );
+    REQUIRE( strcmp(snapshot.iso, "2021-12-07T00:00:00") == 0 );
+
+    // but a new source starts from an empty cache
+    clock_set_source(fake_source);
+    clock_now(&snapshot);
+    REQUIRE( snapshot.posix == 1638795207 );
+    REQUIRE( strcmp(snapshot.iso, "2021-12-06T12:53:27") == 0 );
+
+    clock_set_source(clock_system_source);
+}
+
+TEST_CASE("clock_threads"){
+    fake_now = 0;
+    clock_set_source(fake_source);
+
+    size_t const n_threads = 4;
+    size_t const n_calls = 20000;
+    std::atomic<size_t> n_failures {0};
+
+    std::vector<std::thread> threads;
+    for (size_t i=0; i<n_threads; i++){
+        threads.emplace_back([&n_failures](){
+            kiss_clock_snapshot snapshot;
+            kiss_time_t previous {0};
+            for (size_t j=0; j<n_calls; j++){
+                // all threads move the clock, so that the cache is updated while being read
+                if (j % 16 == 0){
+                    fake_now += 86399;
+                }
+                clock_now(&snapshot);
+                if (!snapshot_is_consistent(snapshot) || snapshot.posix < previous){
+                    n_failures++;
+                }
+                previous = snapshot.posix;
+            }
+        });
+    }
+    for (std::thread &thread : threads){
+        thread.join();
+    }
+
+    REQUIRE( n_failures == 0 );
+
+    clock_set_source(clock_system_source);
+}
+
+TEST_CASE("clock_threads_source_set_back"){
+    // the threads that read a lagging source get the cached second, also when they cannot read the cache because of
+    // the updates of the other threads
+    fake_now = 1000000;
+    clock_set_source(lagging_fake_source);
+
+    size_t const n_threads = 4;
+    size_t const n_calls = 20000;
+    std::atomic<size_t> n_failures {0};
+
+    std::vector<std::thread> threads;
+    for (size_t i=0; i<n_threads; i++){
+        threads.emplace_back([&n_failures, i](){
+            fake_lag = (i % 2 == 0) ? 0 : 100000;
+            kiss_clock_snapshot snapshot;
+            kiss_time_t previous {0};
+            for (size_t j=0; j<n_calls; j++){
+                if (j % 4 == 0){
+                    fake_now += 1;
+                }
+                clock_now(&snapshot);
+                if (!snapshot_is_consistent(snapshot) || snapshot.posix < previous){
+                    n_failures++;
+                }
+                previous = snapshot.posix;
+            }
+        });
+    }
+    for (std::thread &thread : threads){
+        thread.join();
+    }
+
+    REQUIRE( n_failures == 0 );
+
+    clock_set_source(clock_system_source);
+}
+
+TEST_CASE("clock_system_source"){
+    kiss_clock_snapshot snapshot;
+    kiss_time_t const before = clock_system_source();
+    clock_now(&snapshot);
+    kiss_time_t const after = clock_system_source();
+
+    REQUIRE( before >= 1638795207 );
+    REQUIRE( snapshot.posix >= before );
+    REQUIRE( snapshot.posix <= after );
+    REQUIRE( snapshot_is_consistent(snapshot) );
+}
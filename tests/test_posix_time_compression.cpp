@@ -0,0 +1,271 @@
+#include "catch.hpp"
+#include "../src/kiss_posix_time_utils.hpp"
+#include "../src/kiss_posix_time_compression.hpp"
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+TEST_CASE("dod_stream_round_trip"){
+    kiss_time_t const values[] = {1638795207, 1638795217, 1638795227, 1638795237, 1638795238, 1638795300,
+                                  1638795300, 1638795200, 0, 0xFFFFFFFFFFFFFFFF, 3, 1638796000 + 5000, 1638796000 + 5001};
+    size_t const n_values = sizeof(values) / sizeof(values[0]);
+    uint8_t buffer[256];
+    kiss_dod_encoder encoder;
+
+    dod_encoder_init(&encoder, buffer, sizeof(buffer));
+    for (size_t i=0; i<n_values; i++){
+        REQUIRE( dod_encoder_push(&encoder, values[i]) );
+    }
+
+    kiss_time_t decoded[n_values];
+    REQUIRE( dod_decode_stream(buffer, dod_encoder_size(&encoder), n_values, decoded) );
+    for (size_t i=0; i<n_values; i++){
+        REQUIRE( decoded[i] == values[i] );
+    }
+
+    // a truncated stream cannot be decoded
+    REQUIRE( !dod_decode_stream(buffer, dod_encoder_size(&encoder) - 2, n_values, decoded) );
+}
+
+TEST_CASE("dod_encoder_overflow"){
+    uint8_t buffer[10];
+    kiss_dod_encoder encoder;
+
+    dod_encoder_init(&encoder, buffer, sizeof(buffer));
+    REQUIRE( dod_encoder_push(&encoder, 1000) );
+    REQUIRE( dod_encoder_size(&encoder) == 8 );
+    // delta of 10, zigzag 20: 2 bits prefix and 7 bits payload
+    REQUIRE( dod_encoder_push(&encoder, 1010) );
+    REQUIRE( dod_encoder_size(&encoder) == 10 );
+    REQUIRE( !dod_encoder_push(&encoder, 1000000) );
+    REQUIRE( !dod_encoder_push(&encoder, 1000010) );
+}
+
+TEST_CASE("dod_regular_cadence_is_about_one_bit_per_value"){
+    size_t const n_values = 100000;
+    std::vector<kiss_time_t> values(n_values);
+    for (size_t i=0; i<n_values; i++){
+        values[i] = 1638795207 + 60 * i;
+    }
+
+    std::vector<uint8_t> buffer(n_values);
+    size_t const size = dod_encode(values.data(), n_values, 4096, buffer.data(), buffer.size());
+    REQUIRE( size > 0 );
+    REQUIRE( size < n_values / 8 + 25 * 16 );
+
+    std::vector<kiss_time_t> decoded(n_values);
+    REQUIRE( dod_decode(buffer.data(), size, decoded.data(), n_values) == n_values );
+    REQUIRE( decoded == values );
+}
+
+TEST_CASE("dod_blocks_random_access"){
+    size_t const n_values = 1000;
+    size_t const block_length = 64;
+    std::vector<kiss_time_t> values(n_values);
+    kiss_time_t current = 1600000000;
+    for (size_t i=0; i<n_values; i++){
+        // mostly regular, with some jitter and a few large gaps
+        current += 10 + static_cast<kiss_time_t>(rand() % 3);
+        if (rand() % 50 == 0){
+            current += static_cast<kiss_time_t>(rand());
+        }
+        values[i] = current;
+    }
+
+    std::vector<uint8_t> buffer(16 * n_values);
+    size_t const size = dod_encode(values.data(), n_values, block_length, buffer.data(), buffer.size());
+    REQUIRE( size > 0 );
+    REQUIRE( dod_n_values(buffer.data(), size) == n_values );
+    REQUIRE( dod_n_blocks(buffer.data(), size) == 16 );
+
+    kiss_time_t decoded[block_length];
+    REQUIRE( dod_decode_block(buffer.data(), size, 5, decoded) == block_length );
+    for (size_t i=0; i<block_length; i++){
+        REQUIRE( decoded[i] == values[5 * block_length + i] );
+    }
+
+    // the last block is partial
+    REQUIRE( dod_decode_block(buffer.data(), size, 15, decoded) == n_values - 15 * block_length );
+    for (size_t i=0; i<n_values - 15 * block_length; i++){
+        REQUIRE( decoded[i] == values[15 * block_length + i] );
+    }
+
+    REQUIRE( dod_decode_block(buffer.data(), size, 16, decoded) == 0 );
+
+    // too small buffers; a failed encode leaves the buffer in an unspecified state, so use another one
+    std::vector<uint8_t> small_buffer(100);
+    REQUIRE( dod_encode(values.data(), n_values, block_length, small_buffer.data(), small_buffer.size()) == 0 );
+    std::vector<kiss_time_t> all_decoded(n_values);
+    REQUIRE( dod_decode(buffer.data(), size, all_decoded.data(), n_values - 1) == 0 );
+    REQUIRE( dod_decode(buffer.data(), size, all_decoded.data(), n_values) == n_values );
+    REQUIRE( all_decoded == values );
+}
+
+TEST_CASE("for_round_trip"){
+    // several blocks, unsorted values, a partial last block, and a block with all values equal
+    size_t const n_values = 3 * KISS_FOR_BLOCK_LENGTH + 37;
+    std::vector<kiss_time_t> values(n_values);
+    for (size_t i=0; i<n_values; i++){
+        values[i] = 1600000000 + static_cast<kiss_time_t>(rand() % 86400);
+    }
+    for (size_t i=KISS_FOR_BLOCK_LENGTH; i<2*KISS_FOR_BLOCK_LENGTH; i++){
+        values[i] = 1638795207;
+    }
+
+    std::vector<uint8_t> buffer(for_max_encoded_size(n_values));
+    size_t const size = for_encode(values.data(), n_values, buffer.data(), buffer.size());
+    REQUIRE( size > 0 );
+    // offsets within a day take 17 bits, and the block of equal values takes no bits at all
+    REQUIRE( size == 4 + 4 * 9 + (2 * KISS_FOR_BLOCK_LENGTH * 17) / 8 + (37 * 17 + 7) / 8 );
+    REQUIRE( for_n_values(buffer.data(), size) == n_values );
+    REQUIRE( for_n_blocks(buffer.data(), size) == 4 );
+
+    std::vector<kiss_time_t> decoded(n_values);
+    REQUIRE( for_decode(buffer.data(), size, decoded.data(), n_values) == n_values );
+    REQUIRE( decoded == values );
+
+    kiss_time_t block[KISS_FOR_BLOCK_LENGTH];
+    REQUIRE( for_decode_block(buffer.data(), size, 1, block) == KISS_FOR_BLOCK_LENGTH );
+    REQUIRE( block[0] == 1638795207 );
+    REQUIRE( block[KISS_FOR_BLOCK_LENGTH - 1] == 1638795207 );
+    REQUIRE( for_decode_block(buffer.data(), size, 3, block) == 37 );
+    for (size_t i=0; i<37; i++){
+        REQUIRE( block[i] == values[3 * KISS_FOR_BLOCK_LENGTH + i] );
+    }
+    REQUIRE( for_decode_block(buffer.data(), size, 4, block) == 0 );
+
+    // failures
+    REQUIRE( for_decode(buffer.data(), size, decoded.data(), n_values - 1) == 0 );
+    REQUIRE( for_decode(buffer.data(), size - 1, decoded.data(), n_values) == 0 );
+    REQUIRE( for_encode(values.data(), n_values, buffer.data(), size - 1) == 0 );
+}
+
+TEST_CASE("for_full_width"){
+    kiss_time_t const values[] = {0, 0xFFFFFFFFFFFFFFFF, 12, 0x8000000000000000, 1638795207};
+    uint8_t buffer[64];
+
+    size_t const size = for_encode(values, 5, buffer, sizeof(buffer));
+    REQUIRE( size == 4 + 9 + 5 * 8 );
+
+    kiss_time_t decoded[5];
+    REQUIRE( for_decode(buffer, size, decoded, 5) == 5 );
+    for (size_t i=0; i<5; i++){
+        REQUIRE( decoded[i] == values[i] );
+    }
+}
+
+TEST_CASE("for_every_bit_width"){
+    // one block per bit width, 0 to 64, so that both the word by word and the bit by bit unpacking are used
+    size_t const n_values = 65 * KISS_FOR_BLOCK_LENGTH;
+    std::vector<kiss_time_t> values(n_values);
+    uint64_t random_state {0x9E3779B97F4A7C15};
+    for (size_t i=0; i<n_values; i++){
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        size_t const bit_width = i / KISS_FOR_BLOCK_LENGTH;
+        uint64_t const mask = (bit_width < 64) ? (static_cast<uint64_t>(1) << bit_width) - 1 : ~static_cast<uint64_t>(0);
+        // the largest offset in each block, so that the block has exactly this bit width
+        uint64_t const offset = (i % KISS_FOR_BLOCK_LENGTH == 5) ? mask : random_state & mask;
+        values[i] = (bit_width < 64) ? 1000 + offset : offset;
+    }
+
+    std::vector<uint8_t> buffer(for_max_encoded_size(n_values));
+    size_t const size = for_encode(values.data(), n_values, buffer.data(), buffer.size());
+    REQUIRE( size == 4 + 65 * 9 + (KISS_FOR_BLOCK_LENGTH / 8) * (64 * 65 / 2) );
+
+    std::vector<kiss_time_t> decoded(n_values);
+    REQUIRE( for_decode(buffer.data(), size, decoded.data(), n_values) == n_values );
+    REQUIRE( decoded == values );
+}
+
+TEST_CASE("for_decode_to_calendar"){
+    size_t const n_values = KISS_FOR_BLOCK_LENGTH + 5;
+    std::vector<kiss_time_t> values(n_values);
+    for (size_t i=0; i<n_values; i++){
+        values[i] = static_cast<kiss_time_t>(rand());
+    }
+
+    std::vector<uint8_t> buffer(for_max_encoded_size(n_values));
+    size_t const size = for_encode(values.data(), n_values, buffer.data(), buffer.size());
+
+    std::vector<kiss_calendar_time> calendars(n_values);
+    REQUIRE( for_decode_to_calendar(buffer.data(), size, calendars.data(), n_values) == n_values );
+    for (size_t i=0; i<n_values; i++){
+        REQUIRE( calendar_to_posix(&calendars[i]) == values[i] );
+    }
+}
+
+TEST_CASE("for_decode_to_calendar_many_blocks"){
+    // many blocks, with a different bit width in each, and a last block that is not full
+    size_t const n_values = 1000 * KISS_FOR_BLOCK_LENGTH + 77;
+    std::vector<kiss_time_t> values(n_values);
+    uint64_t random_state {0x2545F4914F6CDD1D};
+    for (size_t i=0; i<n_values; i++){
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        size_t const block = i / KISS_FOR_BLOCK_LENGTH;
+        values[i] = 1600000000 + 86400 * block + random_state % (static_cast<uint64_t>(1) << (block % 34));
+    }
+
+    std::vector<uint8_t> buffer(for_max_encoded_size(n_values));
+    size_t const size = for_encode(values.data(), n_values, buffer.data(), buffer.size());
+    REQUIRE( size > 0 );
+
+    std::vector<kiss_calendar_time> calendars(n_values);
+    REQUIRE( for_decode_to_calendar(buffer.data(), size, calendars.data(), n_values) == n_values );
+    for (size_t i=0; i<n_values; i++){
+        REQUIRE( calendar_to_posix(&calendars[i]) == values[i] );
+    }
+
+    // a truncated buffer is not valid, wherever it is cut
+    REQUIRE( for_decode_to_calendar(buffer.data(), size - 1, calendars.data(), n_values) == 0 );
+    REQUIRE( for_decode_to_calendar(buffer.data(), size / 2, calendars.data(), n_values) == 0 );
+    REQUIRE( for_decode_to_calendar(buffer.data(), size, calendars.data(), n_values - 1) == 0 );
+}
+
+TEST_CASE("packed_calendar_round_trip"){
+    kiss_calendar_time working_calendar {2021, 12, 31, 23, 59, 59};
+    kiss_calendar_time unpacked;
+
+    kiss_packed_calendar_t const packed = pack_calendar(&working_calendar);
+    REQUIRE( packed < (static_cast<uint64_t>(1) << 40) );
+    unpack_calendar(packed, &unpacked);
+    REQUIRE( unpacked.year == 2021 );
+    REQUIRE( unpacked.month == 12 );
+    REQUIRE( unpacked.day == 31 );
+    REQUIRE( unpacked.hour == 23 );
+    REQUIRE( unpacked.minute == 59 );
+    REQUIRE( unpacked.second == 59 );
+
+    working_calendar = {KISS_PACKED_CALENDAR_MAX_YEAR, 1, 1, 0, 0, 0};
+    unpack_calendar(pack_calendar(&working_calendar), &unpacked);
+    REQUIRE( unpacked.year == KISS_PACKED_CALENDAR_MAX_YEAR );
+
+    for (size_t i=0; i<10000; i++){
+        kiss_time_t const posix = static_cast<kiss_time_t>(rand()) * 16;
+        REQUIRE( packed_calendar_to_posix(posix_to_packed_calendar(posix)) == posix );
+    }
+}
+
+TEST_CASE("packed_calendar_order"){
+    // packed calendars and stored packed calendars sort as the posix times
+    uint8_t stored_a[KISS_PACKED_CALENDAR_SIZE];
+    uint8_t stored_b[KISS_PACKED_CALENDAR_SIZE];
+
+    for (size_t i=0; i<10000; i++){
+        kiss_time_t const posix_a = static_cast<kiss_time_t>(rand()) * 16;
+        kiss_time_t const posix_b = (i % 2 == 0) ? posix_a + static_cast<kiss_time_t>(rand() % 100) : static_cast<kiss_time_t>(rand()) * 16;
+        kiss_packed_calendar_t const packed_a = posix_to_packed_calendar(posix_a);
+        kiss_packed_calendar_t const packed_b = posix_to_packed_calendar(posix_b);
+
+        REQUIRE( (packed_a < packed_b) == (posix_a < posix_b) );
+        REQUIRE( (packed_a == packed_b) == (posix_a == posix_b) );
+
+        packed_calendar_store(packed_a, stored_a);
+        packed_calendar_store(packed_b, stored_b);
+        REQUIRE( packed_calendar_load(stored_a) == packed_a );
+        REQUIRE( (memcmp(stored_a, stored_b, KISS_PACKED_CALENDAR_SIZE) < 0) == (posix_a < posix_b) );
+    }
+}
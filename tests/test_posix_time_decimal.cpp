@@ -0,0 +1,232 @@
+#include "catch.hpp"
+#include "../src/kiss_posix_time_decimal.hpp"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+TEST_CASE("parse_epoch"){
+    kiss_time_t posix {0};
+
+    REQUIRE( parse_epoch("1638795207", 10, &posix) );
+    REQUIRE( posix == 1638795207 );
+    REQUIRE( parse_epoch("0", 1, &posix) );
+    REQUIRE( posix == 0 );
+    REQUIRE( parse_epoch("00000000000000000042", 20, &posix) );
+    REQUIRE( posix == 42 );
+    REQUIRE( parse_epoch("12345678", 8, &posix) );
+    REQUIRE( posix == 12345678 );
+    REQUIRE( parse_epoch("18446744073709551615", 20, &posix) );
+    REQUIRE( posix == UINT64_MAX );
+
+    // only length_in characters are read
+    REQUIRE( parse_epoch("1638795207 and more", 10, &posix) );
+    REQUIRE( posix == 1638795207 );
+
+    // nothing is written to on failure
+    posix = 42;
+    REQUIRE( !parse_epoch("", 0, &posix) );
+    REQUIRE( !parse_epoch("18446744073709551616", 20, &posix) );
+    REQUIRE( !parse_epoch("99999999999999999999", 20, &posix) );
+    REQUIRE( !parse_epoch("100000000000000000000", 21, &posix) );
+    REQUIRE( !parse_epoch("-1", 2, &posix) );
+    REQUIRE( !parse_epoch("163879520/", 10, &posix) );
+    REQUIRE( !parse_epoch("163879520:", 10, &posix) );
+    REQUIRE( !parse_epoch("1638 95207", 10, &posix) );
+    REQUIRE( !parse_epoch("16387952\xFF", 9, &posix) );
+    REQUIRE( posix == 42 );
+
+    // every digit position, against strtoull
+    char text[32];
+    uint64_t value {1};
+    for (size_t i=0; i<64; i++){
+        int const length = snprintf(text, 32, "%" PRIu64, value);
+        REQUIRE( parse_epoch(text, static_cast<size_t>(length), &posix) );
+        REQUIRE( posix == strtoull(text, nullptr, 10) );
+        value = value * 3 + i;
+    }
+}
+
+TEST_CASE("parse_epoch_calendar_and_milliseconds"){
+    kiss_calendar_time calendar;
+    REQUIRE( parse_epoch("1638795207", 10, &calendar) );
+    REQUIRE( calendar.year == 2021 );
+    REQUIRE( calendar.month == 12 );
+    REQUIRE( calendar.day == 6 );
+    REQUIRE( calendar.hour == 12 );
+    REQUIRE( calendar.minute == 53 );
+    REQUIRE( calendar.second == 27 );
+
+    REQUIRE( parse_epoch("2005949145599", 13, &calendar) );
+    REQUIRE( calendar.year == 65535 );
+    REQUIRE( !parse_epoch("2005949145600", 13, &calendar) );
+
+    kiss_time_t posix {0};
+    uint16_t milliseconds {0};
+    REQUIRE( parse_epoch_milliseconds("1638795207123", 13, &posix, &milliseconds) );
+    REQUIRE( posix == 1638795207 );
+    REQUIRE( milliseconds == 123 );
+    REQUIRE( parse_epoch_milliseconds("7", 1, &posix, &milliseconds) );
+    REQUIRE( posix == 0 );
+    REQUIRE( milliseconds == 7 );
+    REQUIRE( !parse_epoch_milliseconds("1638795207.123", 14, &posix, &milliseconds) );
+}
+
+TEST_CASE("parse_epoch_lines"){
+    char const buffer[] = "1638795207\n99999999999999999999\r\n0\n1582934400\r\nxx\n\n2005949145599\n2005949145600\n42";
+    size_t const buffer_size = sizeof(buffer) - 1;
+    kiss_time_t posix[16];
+    uint8_t valid_mask[2];
+    size_t n_bytes {0};
+
+    REQUIRE( parse_epoch_lines(buffer, buffer_size, posix, valid_mask, 16, &n_bytes) == 9 );
+    REQUIRE( n_bytes == buffer_size );
+    REQUIRE( valid_mask[0] == 0b11001101 );
+    REQUIRE( valid_mask[1] == 0b1 );
+    REQUIRE( posix[0] == 1638795207 );
+    REQUIRE( posix[1] == 0 );
+    REQUIRE( posix[3] == 1582934400 );
+    REQUIRE( posix[7] == 2005949145600 );
+    REQUIRE( posix[8] == 42 );
+
+    // 20 digits, and lines that start with digits but have something else after them
+    char const edge_buffer[] = "18446744073709551615\n1638795207 \n16387952071638795207x\n12\r3\n00000000000000000001\r";
+    REQUIRE( parse_epoch_lines(edge_buffer, sizeof(edge_buffer) - 1, posix, valid_mask, 16, &n_bytes) == 5 );
+    REQUIRE( valid_mask[0] == 0b10001 );
+    REQUIRE( posix[0] == UINT64_MAX );
+    REQUIRE( posix[4] == 1 );
+
+    // the calendar version also rejects what does not fit in a calendar
+    kiss_calendar_time calendars[16];
+    REQUIRE( parse_epoch_lines(buffer, buffer_size, calendars, valid_mask, 16, &n_bytes) == 9 );
+    REQUIRE( valid_mask[0] == 0b01001101 );
+    REQUIRE( calendars[3].year == 2020 );
+    REQUIRE( calendars[3].month == 2 );
+    REQUIRE( calendars[3].day == 29 );
+    REQUIRE( calendars[7].year == 0 );
+
+    // stop after max_lines, and go on from there
+    REQUIRE( parse_epoch_lines(buffer, buffer_size, posix, valid_mask, 2, &n_bytes) == 2 );
+    REQUIRE( n_bytes == 33 );
+    REQUIRE( parse_epoch_lines(buffer + n_bytes, buffer_size - n_bytes, posix, valid_mask, 16, &n_bytes) == 7 );
+    REQUIRE( posix[1] == 1582934400 );
+}
+
+TEST_CASE("parse_epoch_lines_calendar_many_lines"){
+    // more lines than the calendar version parses in one chunk, with invalid ones in all of them
+    std::string buffer;
+    char line[32];
+    size_t const n_lines {300};
+    for (size_t i=0; i<n_lines; i++){
+        kiss_time_t const posix = (i % 7 == 3) ? LAST_POSIX_IN_CALENDAR_TIME + i : 1600000000 + 86399 * i;
+        snprintf(line, 32, (i % 11 == 5) ? "x%" PRIu64 "\n" : "%" PRIu64 "\r\n", posix);
+        buffer += line;
+    }
+
+    std::vector<kiss_time_t> posix(n_lines);
+    std::vector<kiss_calendar_time> calendars(n_lines);
+    std::vector<uint8_t> posix_mask((n_lines + 7) / 8);
+    std::vector<uint8_t> calendar_mask((n_lines + 7) / 8);
+    size_t n_bytes {0};
+
+    REQUIRE( parse_epoch_lines(buffer.data(), buffer.size(), posix.data(), posix_mask.data(), n_lines, &n_bytes) == n_lines );
+    REQUIRE( parse_epoch_lines(buffer.data(), buffer.size(), calendars.data(), calendar_mask.data(), n_lines, &n_bytes) == n_lines );
+    REQUIRE( n_bytes == buffer.size() );
+
+    for (size_t i=0; i<n_lines; i++){
+        bool const posix_valid = (posix_mask[i / 8] >> (i % 8)) & 1;
+        bool const calendar_valid = (calendar_mask[i / 8] >> (i % 8)) & 1;
+        REQUIRE( posix_valid == (i % 11 != 5) );
+        REQUIRE( calendar_valid == (posix_valid && i % 7 != 3) );
+        if (calendar_valid){
+            REQUIRE( calendar_to_posix(&calendars[i]) == posix[i] );
+        }
+        else{
+            REQUIRE( calendars[i].year == 0 );
+        }
+    }
+
+    // max_lines that is not a multiple of 8, and the rest in a next call
+    REQUIRE( parse_epoch_lines(buffer.data(), buffer.size(), calendars.data(), calendar_mask.data(), 77, &n_bytes) == 77 );
+    REQUIRE( parse_epoch_lines(buffer.data() + n_bytes, buffer.size() - n_bytes, calendars.data(), calendar_mask.data(), n_lines, &n_bytes) == n_lines - 77 );
+    REQUIRE( calendar_to_posix(&calendars[0]) == posix[77] );
+}
+
+TEST_CASE("print_epoch"){
+    char buffer[32];
+    char expected[32];
+
+    REQUIRE( print_epoch(kiss_time_t {1638795207}, buffer, 32) == 10 );
+    REQUIRE( strcmp(buffer, "1638795207") == 0 );
+    REQUIRE( print_epoch(kiss_time_t {0}, buffer, 32) == 1 );
+    REQUIRE( strcmp(buffer, "0") == 0 );
+    REQUIRE( print_epoch(UINT64_MAX, buffer, 32) == 20 );
+    REQUIRE( strcmp(buffer, "18446744073709551615") == 0 );
+
+    // buffer too small
+    REQUIRE( print_epoch(kiss_time_t {1638795207}, buffer, 10) == 0 );
+    REQUIRE( buffer[0] == '\0' );
+    REQUIRE( print_epoch(kiss_time_t {1638795207}, buffer, 11) == 10 );
+
+    kiss_calendar_time const calendar {2021, 12, 6, 12, 53, 27};
+    REQUIRE( print_epoch(&calendar, buffer, 32) == 10 );
+    REQUIRE( strcmp(buffer, "1638795207") == 0 );
+
+    REQUIRE( print_epoch_milliseconds(1638795207, 45, buffer, 32) == 13 );
+    REQUIRE( strcmp(buffer, "1638795207045") == 0 );
+    REQUIRE( print_epoch_milliseconds(18446744073709551, 615, buffer, 32) == 20 );
+    REQUIRE( strcmp(buffer, "18446744073709551615") == 0 );
+
+    // out of range: the number of milliseconds would wrap around
+    REQUIRE( print_epoch_milliseconds(1638795207, 1000, buffer, 32) == 0 );
+    REQUIRE( buffer[0] == '\0' );
+    REQUIRE( print_epoch_milliseconds(18446744073709551, 616, buffer, 32) == 0 );
+    REQUIRE( print_epoch_milliseconds(18446744073709552, 0, buffer, 32) == 0 );
+    REQUIRE( print_epoch_milliseconds(UINT64_MAX, 0, buffer, 32) == 0 );
+    REQUIRE( buffer[31] == '\0' );
+
+    // every number of digits, and round trips, against snprintf
+    uint64_t value {1};
+    for (size_t i=0; i<64; i++){
+        size_t const length = print_epoch(value, buffer, 32);
+        REQUIRE( static_cast<int>(length) == snprintf(expected, 32, "%" PRIu64, value) );
+        REQUIRE( strcmp(buffer, expected) == 0 );
+
+        kiss_time_t parsed {0};
+        REQUIRE( parse_epoch(buffer, length, &parsed) );
+        REQUIRE( parsed == value );
+
+        REQUIRE( print_epoch(value - 1, buffer, 32) == static_cast<size_t>(snprintf(expected, 32, "%" PRIu64, value - 1)) );
+        REQUIRE( strcmp(buffer, expected) == 0 );
+        value = value * 3 + i;
+    }
+    for (kiss_time_t posix=0; posix<100000000000; posix+=987654321){
+        size_t const length = print_epoch(posix, buffer, 32);
+        REQUIRE( static_cast<int>(length) == snprintf(expected, 32, "%" PRIu64, posix) );
+        REQUIRE( strcmp(buffer, expected) == 0 );
+    }
+}
+
+TEST_CASE("print_epoch_arena"){
+    char slab[32];
+    kiss_text_arena arena;
+    text_arena_init(&arena, slab, 32);
+
+    kiss_time_t const posix[] = {1638795207, 0, 1580000000, 1590000000};
+    kiss_calendar_time calendars[4];
+    posix_to_calendar_batch(posix, calendars, 4);
+    kiss_text_view views[4];
+
+    // stops when there is no room left for the next entry
+    REQUIRE( print_epoch_arena(posix, 2, &arena, views) == 2 );
+    REQUIRE( print_epoch_arena(&calendars[2], 2, &arena, &views[2]) == 2 );
+    REQUIRE( arena.size == 31 );
+    REQUIRE( print_epoch_arena(posix, 1, &arena, views) == 0 );
+
+    REQUIRE( views[0].length == 10 );
+    REQUIRE( strncmp(&slab[views[0].offset], "1638795207", 10) == 0 );
+    REQUIRE( views[1].length == 1 );
+    REQUIRE( slab[views[1].offset] == '0' );
+    REQUIRE( strncmp(&slab[views[3].offset], "1590000000", 10) == 0 );
+}
@@ -48,4 +48,170 @@ TEST_CASE("iso_formatting_too_short_buffer"){
     bool result = print_iso(&working_calendar, &too_short_working_buffer[0], 19);
     REQUIRE(!result);
     REQUIRE( strncmp(too_short_result, too_short_working_buffer, 19) == 0 );
-}
\ No newline at end of file
+}
+TEST_CASE("iso_formatter"){
+    kiss_iso_formatter formatter;
+    iso_formatter_init(&formatter);
+    char expected[20];
+
+    // consecutive seconds, over the end of a day, month, year, and a leap day
+    kiss_time_t const starts[] = {1638835140, 1643673540, 1640995140, 1582934340, 1583020740, 0};
+    for (kiss_time_t start : starts){
+        for (kiss_time_t posix=start; posix<start+200; posix++){
+            print_iso(posix, expected, 20);
+            REQUIRE( strncmp(iso_formatter_print(&formatter, posix), expected, 20) == 0 );
+        }
+    }
+
+    // consecutive seconds over a whole day
+    for (kiss_time_t posix=1638795207; posix<1638795207+SECS_PER_DAY+10; posix++){
+        print_iso(posix, expected, 20);
+        REQUIRE( strncmp(iso_formatter_print(&formatter, posix), expected, 20) == 0 );
+    }
+
+    // small steps, both ways, and large jumps
+    uint64_t random_state {0x9E3779B97F4A7C15};
+    kiss_time_t posix {1638795207};
+    for (size_t i=0; i<100000; i++){
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        switch (random_state % 4){
+            case 0:
+                posix += random_state % 7200;
+                break;
+            case 1:
+                posix -= random_state % 7200;
+                break;
+            case 2:
+                posix = random_state % 4102444800;
+                break;
+            default:
+                posix += 1;
+                break;
+        }
+        print_iso(posix, expected, 20);
+        REQUIRE( strncmp(iso_formatter_print(&formatter, posix), expected, 20) == 0 );
+        REQUIRE( calendar_to_posix(&formatter.calendar) == posix );
+    }
+}
+
+TEST_CASE("print_iso_arena"){
+    char slab[19 * 100 + 10];
+    kiss_text_arena arena;
+    text_arena_init(&arena, slab, sizeof(slab));
+
+    kiss_time_t posix[120];
+    kiss_calendar_time calendars[120];
+    for (size_t i=0; i<120; i++){
+        posix[i] = 1638795207 + 86413 * i;
+        posix_to_calendar(posix[i], &calendars[i]);
+    }
+
+    kiss_text_view views[120];
+    char expected[20];
+
+    // two batches fill the arena, and the second one stops when it is full
+    REQUIRE( print_iso_arena(posix, 60, &arena, views) == 60 );
+    REQUIRE( print_iso_arena(&calendars[60], 60, &arena, &views[60]) == 40 );
+    REQUIRE( arena.size == 19 * 100 );
+    REQUIRE( print_iso_arena(posix, 1, &arena, views) == 0 );
+
+    for (size_t i=0; i<100; i++){
+        print_iso(posix[i], expected, 20);
+        REQUIRE( views[i].length == 19 );
+        REQUIRE( views[i].offset == 19 * i );
+        REQUIRE( strncmp(&slab[views[i].offset], expected, 19) == 0 );
+        REQUIRE( text_view_string(&arena, &views[i]) == std::string_view(expected) );
+    }
+
+    // the arena is reused after clearing
+    text_arena_clear(&arena);
+    REQUIRE( print_iso_arena(&posix[110], 10, &arena, views) == 10 );
+    print_iso(posix[110], expected, 20);
+    REQUIRE( views[0].offset == 0 );
+    REQUIRE( text_view_string(&arena, &views[0]) == std::string_view(expected) );
+}
+
+TEST_CASE("print_rfc3339"){
+    char buffer[64];
+
+    kiss_rfc3339_options options {0, 0};
+    REQUIRE( rfc3339_size(&options) == 20 );
+    REQUIRE( print_rfc3339(1638795207, 999999999, &options, buffer, 64) == 20 );
+    REQUIRE( strcmp(buffer, "2021-12-06T12:53:27Z") == 0 );
+
+    options = kiss_rfc3339_options {3, 0};
+    REQUIRE( rfc3339_size(&options) == 24 );
+    REQUIRE( print_rfc3339(1638795207, 125999999, &options, buffer, 64) == 24 );
+    REQUIRE( strcmp(buffer, "2021-12-06T12:53:27.125Z") == 0 );
+
+    options = kiss_rfc3339_options {6, 120};
+    REQUIRE( rfc3339_size(&options) == 32 );
+    REQUIRE( print_rfc3339(1638795207, 123456789, &options, buffer, 64) == 32 );
+    REQUIRE( strcmp(buffer, "2021-12-06T14:53:27.123456+02:00") == 0 );
+
+    options = kiss_rfc3339_options {9, -330};
+    REQUIRE( rfc3339_size(&options) == 35 );
+    REQUIRE( print_rfc3339(1638795207, 4567, &options, buffer, 64) == 35 );
+    REQUIRE( strcmp(buffer, "2021-12-06T07:23:27.000004567-05:30") == 0 );
+
+    // the offset moves the date too
+    options = kiss_rfc3339_options {0, 1439};
+    REQUIRE( print_rfc3339(1638835200 - 1, 0, &options, buffer, 64) == 25 );
+    REQUIRE( strcmp(buffer, "2021-12-07T23:58:59+23:59") == 0 );
+
+    // exactly the size, with the null byte
+    options = kiss_rfc3339_options {0, -60};
+    REQUIRE( print_rfc3339(3600, 0, &options, buffer, 26) == 25 );
+    REQUIRE( strcmp(buffer, "1970-01-01T00:00:00-01:00") == 0 );
+    REQUIRE( print_rfc3339(3600, 0, &options, buffer, 25) == 0 );
+    REQUIRE( buffer[0] == '\0' );
+
+    // what cannot be printed
+    REQUIRE( print_rfc3339(3599, 0, &options, buffer, 64) == 0 );
+    options = kiss_rfc3339_options {0, 0};
+    REQUIRE( print_rfc3339(253402300799, 0, &options, buffer, 64) == 20 );
+    REQUIRE( strcmp(buffer, "9999-12-31T23:59:59Z") == 0 );
+    REQUIRE( print_rfc3339(253402300800, 0, &options, buffer, 64) == 0 );
+    REQUIRE( print_rfc3339(0, 1000000000, &options, buffer, 64) == 0 );
+    options = kiss_rfc3339_options {10, 0};
+    REQUIRE( print_rfc3339(0, 0, &options, buffer, 64) == 0 );
+    options = kiss_rfc3339_options {0, 1440};
+    REQUIRE( print_rfc3339(0, 0, &options, buffer, 64) == 0 );
+
+    // the same date and time as print_iso
+    char expected[20];
+    options = kiss_rfc3339_options {3, 0};
+    for (kiss_time_t posix=0; posix<253402300800; posix+=7654321){
+        REQUIRE( print_rfc3339(posix, 0, &options, buffer, 64) == 24 );
+        REQUIRE( print_iso(posix, expected, 20) );
+        REQUIRE( strncmp(buffer, expected, 19) == 0 );
+        REQUIRE( strcmp(&buffer[19], ".000Z") == 0 );
+    }
+}
+
+TEST_CASE("print_rfc3339_arena"){
+    char slab[60];
+    kiss_text_arena arena;
+    text_arena_init(&arena, slab, 60);
+
+    kiss_time_t const posix[] = {1638795207, 0, 1580000000};
+    uint32_t const nanoseconds[] = {1000000, 2000000, 3000000};
+    kiss_rfc3339_options const options {3, 0};
+    kiss_text_view views[3];
+
+    // stops when there is no room left
+    REQUIRE( print_rfc3339_arena(posix, nanoseconds, 3, &options, &arena, views) == 2 );
+    REQUIRE( arena.size == 48 );
+    REQUIRE( views[1].offset == 24 );
+    REQUIRE( views[1].length == 24 );
+    REQUIRE( strncmp(&slab[views[0].offset], "2021-12-06T12:53:27.001Z", 24) == 0 );
+    REQUIRE( strncmp(&slab[views[1].offset], "1970-01-01T00:00:00.002Z", 24) == 0 );
+
+    // no fractions given, and stops at an entry that cannot be printed
+    text_arena_clear(&arena);
+    kiss_time_t const late_posix[] = {1638795207, 253402300800};
+    REQUIRE( print_rfc3339_arena(late_posix, nullptr, 2, &options, &arena, views) == 1 );
+    REQUIRE( strncmp(&slab[views[0].offset], "2021-12-06T12:53:27.000Z", 24) == 0 );
+}
@@ -0,0 +1,103 @@
+#include "catch.hpp"
+#include "../src/kiss_posix_time_fixed_format.hpp"
+#include <string.h>
+
+static constexpr char log_pattern[] = "%Y%m%d %H%M%S";
+static constexpr char rfc1123_pattern[] = "%a, %d %b %Y %H:%M:%S GMT";
+static constexpr char ordinal_pattern[] = "%Y-%j %u 100%%";
+static constexpr char short_year_pattern[] = "%d/%m/%y";
+
+// the sizes are compile time constants
+static_assert(fixed_format_size<KISS_FIXED_FORMAT_ISO>() == 19, "ISO is 19 characters");
+static_assert(fixed_format_size<log_pattern>() == 15, "log is 15 characters");
+static_assert(fixed_format_size<rfc1123_pattern>() == 29, "RFC 1123 is 29 characters");
+static_assert(fixed_format_size<ordinal_pattern>() == 15, "ordinal is 15 characters");
+static_assert(fixed_format_n_ops<ordinal_pattern>() == 10, "ordinal has 10 ops");
+
+// invalid patterns are detected at compile time
+static constexpr char full_name_pattern[] = "%B %Y";
+static constexpr char lone_percent_pattern[] = "%Y%";
+static_assert(!fixed_format_is_valid<full_name_pattern>(), "full names do not have a fixed width");
+static_assert(!fixed_format_is_valid<lone_percent_pattern>(), "a lone % is not a conversion");
+
+TEST_CASE("fixed_format_print"){
+    char buffer[64];
+    char expected[64];
+
+    kiss_calendar_time const calendar {2020, 2, 29, 23, 5, 9};
+    fixed_format_print<ordinal_pattern>(&calendar, buffer);
+    REQUIRE( strncmp(buffer, "2020-060 6 100%", 15) == 0 );
+
+    fixed_format_print<rfc1123_pattern>(kiss_time_t {1638795207}, buffer);
+    REQUIRE( strncmp(buffer, "Mon, 06 Dec 2021 12:53:27 GMT", 29) == 0 );
+
+    // the same output as the run time formatter, and as print_iso
+    kiss_format_program rfc1123_program;
+    REQUIRE( format_compile(rfc1123_pattern, &rfc1123_program) );
+
+    uint64_t random_state {0x9E3779B97F4A7C15};
+    for (size_t i=0; i<100000; i++){
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        kiss_time_t const posix = random_state % 253402300800;
+
+        fixed_format_print<KISS_FIXED_FORMAT_ISO>(posix, buffer);
+        print_iso(posix, expected, 20);
+        REQUIRE( strncmp(buffer, expected, 19) == 0 );
+
+        fixed_format_print<rfc1123_pattern>(posix, buffer);
+        format_print(&rfc1123_program, posix, expected, 64);
+        REQUIRE( strncmp(buffer, expected, 29) == 0 );
+    }
+}
+
+TEST_CASE("fixed_format_parse"){
+    kiss_time_t posix;
+    kiss_calendar_time calendar;
+
+    REQUIRE( fixed_format_parse<log_pattern>("20211206 125327", &posix) );
+    REQUIRE( posix == 1638795207 );
+    REQUIRE( fixed_format_parse<rfc1123_pattern>("Mon, 06 Dec 2021 12:53:27 GMT", &posix) );
+    REQUIRE( posix == 1638795207 );
+    REQUIRE( fixed_format_parse<ordinal_pattern>("2020-060 6 100%", &calendar) );
+    REQUIRE( calendar.month == 2 );
+    REQUIRE( calendar.day == 29 );
+    REQUIRE( fixed_format_parse<short_year_pattern>("31/12/99", &calendar) );
+    REQUIRE( calendar.year == 1999 );
+    REQUIRE( !fixed_format_parse<short_year_pattern>("31/12/69", &posix) );
+    REQUIRE( fixed_format_parse<short_year_pattern>("01/01/68", &calendar) );
+    REQUIRE( calendar.year == 2068 );
+
+    // round trips
+    uint64_t random_state {0x2545F4914F6CDD1D};
+    char buffer[64];
+    for (size_t i=0; i<100000; i++){
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        kiss_time_t const posix_in = random_state % 253402300800;
+
+        fixed_format_print<rfc1123_pattern>(posix_in, buffer);
+        REQUIRE( fixed_format_parse<rfc1123_pattern>(buffer, &posix) );
+        REQUIRE( posix == posix_in );
+
+        fixed_format_print<KISS_FIXED_FORMAT_ISO>(posix_in, buffer);
+        REQUIRE( fixed_format_parse<KISS_FIXED_FORMAT_ISO>(buffer, &posix) );
+        REQUIRE( posix == posix_in );
+    }
+
+    // invalid texts; the output is not written to
+    posix = 12;
+    REQUIRE( !fixed_format_parse<log_pattern>("20211206-125327", &posix) );
+    REQUIRE( !fixed_format_parse<log_pattern>("2021120a 125327", &posix) );
+    REQUIRE( !fixed_format_parse<log_pattern>("20210229 125327", &posix) );
+    REQUIRE( !fixed_format_parse<log_pattern>("20211206 245327", &posix) );
+    REQUIRE( !fixed_format_parse<log_pattern>("19691231 235959", &posix) );
+    REQUIRE( !fixed_format_parse<rfc1123_pattern>("Tue, 06 Dec 2021 12:53:27 GMT", &posix) );
+    REQUIRE( !fixed_format_parse<rfc1123_pattern>("Mon, 06 Dex 2021 12:53:27 GMT", &posix) );
+    REQUIRE( !fixed_format_parse<ordinal_pattern>("2021-366 5 100%", &posix) );
+    REQUIRE( !fixed_format_parse<ordinal_pattern>("2021-000 5 100%", &posix) );
+    REQUIRE( !fixed_format_parse<ordinal_pattern>("2021-001 8 100%", &posix) );
+    REQUIRE( posix == 12 );
+}
@@ -0,0 +1,228 @@
+#include "catch.hpp"
+#include "../src/kiss_posix_time_format.hpp"
+#include <string.h>
+#include <time.h>
+
+TEST_CASE("format_compile"){
+    kiss_format_program program;
+
+    REQUIRE( format_compile("%d/%m/%Y %H:%M", &program) );
+    REQUIRE( program.n_ops == 9 );
+    REQUIRE( program.max_length == 17 );
+    REQUIRE( !program.needs_posix );
+
+    // literals next to each other are merged, including %%
+    REQUIRE( format_compile("at 100%% %s", &program) );
+    REQUIRE( program.n_ops == 2 );
+    REQUIRE( program.ops[0].literal_length == 8 );
+    REQUIRE( program.needs_posix );
+
+    REQUIRE( format_compile("", &program) );
+    REQUIRE( program.n_ops == 0 );
+
+    // errors
+    REQUIRE( !format_compile("%Y-%q", &program) );
+    REQUIRE( !format_compile("%Y %", &program) );
+    REQUIRE( !format_compile("%H%M%S%H%M%S%H%M%S%H%M%S%H%M%S%H%M%S%H%M%S%H%M%S%H%M%S%H%M%S%H%M%S", &program) );
+    char long_literal[100];
+    memset(long_literal, 'x', 99);
+    long_literal[99] = '\0';
+    REQUIRE( !format_compile(long_literal, &program) );
+}
+
+TEST_CASE("format_print"){
+    kiss_format_program program;
+    char buffer[64];
+
+    // RFC 1123, as in the HTTP Date header
+    REQUIRE( format_compile("%a, %d %b %Y %H:%M:%S GMT", &program) );
+    REQUIRE( format_print(&program, kiss_time_t {1638795207}, buffer, 64) == 29 );
+    REQUIRE( strcmp(buffer, "Mon, 06 Dec 2021 12:53:27 GMT") == 0 );
+
+    kiss_calendar_time const calendar {2020, 2, 29, 23, 5, 9};
+    REQUIRE( format_compile("%A %B %j %u %y %s %%", &program) );
+    REQUIRE( format_print(&program, &calendar, buffer, 64) > 0 );
+    REQUIRE( strcmp(buffer, "Saturday February 060 6 20 1583017509 %") == 0 );
+
+    REQUIRE( format_compile("%s", &program) );
+    REQUIRE( format_print(&program, kiss_time_t {0}, buffer, 64) == 1 );
+    REQUIRE( strcmp(buffer, "0") == 0 );
+    REQUIRE( format_print(&program, kiss_time_t {2005949145599}, buffer, 64) == 13 );
+    REQUIRE( strcmp(buffer, "2005949145599") == 0 );
+
+    // years with 5 digits
+    kiss_calendar_time const late_calendar {12345, 1, 2, 3, 4, 5};
+    REQUIRE( format_compile("%Y-%m-%d", &program) );
+    REQUIRE( format_print(&program, &late_calendar, buffer, 64) == 11 );
+    REQUIRE( strcmp(buffer, "12345-01-02") == 0 );
+
+    // a buffer that is too small for the longest output, even if this output would fit
+    REQUIRE( format_compile("%B", &program) );
+    REQUIRE( format_print(&program, &calendar, buffer, 9) == 0 );
+    REQUIRE( buffer[0] == '\0' );
+    REQUIRE( format_print(&program, &calendar, buffer, 10) == 8 );
+}
+
+TEST_CASE("format_print_against_strftime"){
+    char const *const patterns[] = {
+        "%a, %d %b %Y %H:%M:%S GMT", "%d/%m/%Y %H:%M", "%A %B %j %u %y", "%Y-%m-%dT%H:%M:%S", "100%% %S%M%H"
+    };
+
+    uint64_t random_state {0x9E3779B97F4A7C15};
+    for (char const *pattern : patterns){
+        kiss_format_program program;
+        REQUIRE( format_compile(pattern, &program) );
+
+        for (size_t i=0; i<20000; i++){
+            random_state ^= random_state << 13;
+            random_state ^= random_state >> 7;
+            random_state ^= random_state << 17;
+            kiss_time_t const posix = random_state % 253402300800;
+
+            time_t const time_in = static_cast<time_t>(posix);
+            struct tm broken_down;
+            gmtime_r(&time_in, &broken_down);
+            char expected[64];
+            // the patterns are the literals above
+            #pragma GCC diagnostic push
+            #pragma GCC diagnostic ignored "-Wformat-nonliteral"
+            size_t const expected_length = strftime(expected, 64, pattern, &broken_down);
+            #pragma GCC diagnostic pop
+
+            char buffer[64];
+            REQUIRE( format_print(&program, posix, buffer, 64) == expected_length );
+            REQUIRE( strcmp(buffer, expected) == 0 );
+        }
+    }
+}
+
+TEST_CASE("format_print_arena"){
+    kiss_format_program program;
+    REQUIRE( format_compile("%d %B %Y", &program) );
+    REQUIRE( program.max_length == 18 );
+
+    char slab[80];
+    kiss_text_arena arena;
+    text_arena_init(&arena, slab, 80);
+
+    kiss_time_t const posix[] = {1638795207, 1580000000, 1590000000, 1600000000, 1610000000, 1620000000};
+    kiss_calendar_time calendars[6];
+    posix_to_calendar_batch(posix, calendars, 6);
+    kiss_text_view views[6];
+
+    // stops when there is no room left for the longest output
+    REQUIRE( format_print_arena(&program, posix, 3, &arena, views) == 3 );
+    REQUIRE( format_print_arena(&program, &calendars[3], 3, &arena, &views[3]) == 2 );
+
+    char expected[64];
+    for (size_t i=0; i<5; i++){
+        size_t const expected_length = format_print(&program, posix[i], expected, 64);
+        REQUIRE( views[i].length == expected_length );
+        REQUIRE( strncmp(&slab[views[i].offset], expected, expected_length) == 0 );
+    }
+    REQUIRE( views[1].offset == views[0].length );
+    REQUIRE( strncmp(&slab[views[0].offset], "06 December 2021", views[0].length) == 0 );
+}
+
+TEST_CASE("format_parse"){
+    kiss_format_program program;
+    kiss_time_t posix {0};
+
+    REQUIRE( format_compile("%Y%m%d%H%M%S", &program) );
+    REQUIRE( format_parse(&program, "20211206125327", 14, &posix) );
+    REQUIRE( posix == 1638795207 );
+    REQUIRE( format_parse(&program, "19700101000000", 14, &posix) );
+    REQUIRE( posix == 0 );
+
+    // nothing is written to on failure
+    posix = 42;
+    REQUIRE( !format_parse(&program, "20211306125327", 14, &posix) );     // month
+    REQUIRE( !format_parse(&program, "20210229000000", 14, &posix) );     // not a leap year
+    REQUIRE( !format_parse(&program, "20211206245327", 14, &posix) );     // hour
+    REQUIRE( !format_parse(&program, "19691231235959", 14, &posix) );     // before the epoch
+    REQUIRE( !format_parse(&program, "2021120612532", 13, &posix) );      // too short
+    REQUIRE( !format_parse(&program, "202112061253270", 15, &posix) );    // too long
+    REQUIRE( !format_parse(&program, "2021120612532x", 14, &posix) );
+    REQUIRE( posix == 42 );
+
+    REQUIRE( format_compile("%d/%m/%Y %H:%M:%S", &program) );
+    REQUIRE( format_parse(&program, "06/12/2021 12:53:27", 19, &posix) );
+    REQUIRE( posix == 1638795207 );
+    REQUIRE( !format_parse(&program, "06-12-2021 12:53:27", 19, &posix) );
+
+    REQUIRE( format_compile("%Y-%j", &program) );
+    REQUIRE( format_parse(&program, "2021-340", 8, &posix) );
+    REQUIRE( posix == 1638748800 );
+    REQUIRE( format_parse(&program, "2020-366", 8, &posix) );
+    REQUIRE( posix == 1609372800 );
+    REQUIRE( !format_parse(&program, "2021-366", 8, &posix) );
+    REQUIRE( !format_parse(&program, "2021-000", 8, &posix) );
+
+    REQUIRE( format_compile("%s", &program) );
+    REQUIRE( format_parse(&program, "1638795207", 10, &posix) );
+    REQUIRE( posix == 1638795207 );
+    REQUIRE( format_parse(&program, "18446744073709551615", 20, &posix) );
+    REQUIRE( posix == UINT64_MAX );
+    REQUIRE( !format_parse(&program, "18446744073709551616", 20, &posix) );
+    REQUIRE( !format_parse(&program, "", 0, &posix) );
+    REQUIRE( !format_parse(&program, "-1", 2, &posix) );
+
+    // names, and the week day must be the one of the date
+    REQUIRE( format_compile("%a, %d %b %Y %H:%M:%S GMT", &program) );
+    REQUIRE( format_parse(&program, "Mon, 06 Dec 2021 12:53:27 GMT", 29, &posix) );
+    REQUIRE( posix == 1638795207 );
+    REQUIRE( !format_parse(&program, "Tue, 06 Dec 2021 12:53:27 GMT", 29, &posix) );
+    REQUIRE( !format_parse(&program, "Mon, 06 Dex 2021 12:53:27 GMT", 29, &posix) );
+
+    REQUIRE( format_compile("%A %d %B %Y", &program) );
+    REQUIRE( format_parse(&program, "Monday 06 December 2021", 23, &posix) );
+    REQUIRE( posix == 1638748800 );
+    REQUIRE( !format_parse(&program, "Mon 06 December 2021", 20, &posix) );
+}
+
+TEST_CASE("format_parse_round_trip"){
+    char const *const patterns[] = {"%Y%m%d%H%M%S", "%d/%m/%Y %H:%M:%S", "%A, %d %B %Y %H:%M:%S", "%Y-%j %H%M%S %u", "%s"};
+    char buffer[64];
+
+    for (char const *const pattern : patterns){
+        kiss_format_program program;
+        REQUIRE( format_compile(pattern, &program) );
+
+        for (kiss_time_t posix=0; posix<253402300800; posix+=7654321){
+            size_t const length = format_print(&program, posix, buffer, 64);
+            kiss_time_t parsed {0};
+            REQUIRE( format_parse(&program, buffer, length, &parsed) );
+            REQUIRE( parsed == posix );
+        }
+    }
+}
+
+TEST_CASE("format_parse_lines"){
+    kiss_format_program program;
+    REQUIRE( format_compile("%Y%m%d%H%M%S", &program) );
+
+    char const buffer[] = "20211206125327\n20211306125327\r\n19700101000000\n20200229000000\r\nxx\n\n"
+                          "20211206125327\n20211206125328\n20211206125329\n20211206125330";
+    size_t const buffer_size = sizeof(buffer) - 1;
+    kiss_time_t posix[16];
+    uint8_t valid_mask[2];
+    size_t n_bytes {0};
+
+    REQUIRE( format_parse_lines(&program, buffer, buffer_size, posix, valid_mask, 16, &n_bytes) == 10 );
+    REQUIRE( n_bytes == buffer_size );
+    REQUIRE( valid_mask[0] == 0b11001101 );
+    REQUIRE( valid_mask[1] == 0b11 );
+    REQUIRE( posix[0] == 1638795207 );
+    REQUIRE( posix[1] == 0 );
+    REQUIRE( posix[2] == 0 );
+    REQUIRE( posix[3] == 1582934400 );
+    REQUIRE( posix[9] == 1638795210 );
+
+    // stop after max_lines, and go on from there
+    REQUIRE( format_parse_lines(&program, buffer, buffer_size, posix, valid_mask, 2, &n_bytes) == 2 );
+    REQUIRE( n_bytes == 31 );
+    REQUIRE( valid_mask[0] == 0b01 );
+    REQUIRE( format_parse_lines(&program, buffer + n_bytes, buffer_size - n_bytes, posix, valid_mask, 16, &n_bytes) == 8 );
+    REQUIRE( posix[0] == 0 );
+    REQUIRE( posix[1] == 1582934400 );
+}
@@ -0,0 +1,136 @@
+#include "catch.hpp"
+#include "../src/kiss_posix_time_utils.hpp"
+#include "../src/kiss_posix_time_extras.hpp"
+#include "../src/kiss_posix_time_instrumentation.hpp"
+#include "../src/kiss_posix_time_backends.hpp"
+
+// the instrumentation only exists when KISS_POSIX_TIME_INSTRUMENTATION is defined; these tests are run by a
+// separate build that defines it
+#ifdef KISS_POSIX_TIME_INSTRUMENTATION
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static uint64_t histogram_total(kiss_instrumentation_snapshot const &snapshot, uint8_t const timer){
+    uint64_t total {0};
+    for (size_t bucket=0; bucket<KISS_N_INSTRUMENTATION_BUCKETS; bucket++){
+        total += snapshot.histograms[timer][bucket];
+    }
+    return total;
+}
+
+TEST_CASE("instrumentation_counts"){
+    kiss_instrumentation_snapshot before;
+    kiss_instrumentation_snapshot after;
+    instrumentation_snapshot(&before);
+
+    kiss_calendar_time calendar {2021, 12, 6, 12, 53, 27};
+    kiss_time_t posix = calendar_to_posix(&calendar);
+    posix_to_calendar(posix, &calendar);
+    posix_to_calendar(posix + 1, &calendar);
+    calendar_is_valid(&calendar);
+    char buffer[20];
+    print_iso(posix, buffer, 20);
+
+    kiss_time_t posix_values[10] {};
+    kiss_calendar_time calendars[10];
+    posix_to_calendar_batch(posix_values, calendars, 10);
+
+    instrumentation_snapshot(&after);
+
+    // print_iso(posix) goes through posix_to_calendar
+    REQUIRE( after.counters[KISS_COUNT_CALENDAR_TO_POSIX] - before.counters[KISS_COUNT_CALENDAR_TO_POSIX] == 1 );
+    REQUIRE( after.counters[KISS_COUNT_POSIX_TO_CALENDAR] - before.counters[KISS_COUNT_POSIX_TO_CALENDAR] == 3 );
+    REQUIRE( after.counters[KISS_COUNT_CALENDAR_IS_VALID] - before.counters[KISS_COUNT_CALENDAR_IS_VALID] == 1 );
+    REQUIRE( after.counters[KISS_COUNT_PRINT_ISO] - before.counters[KISS_COUNT_PRINT_ISO] == 1 );
+    REQUIRE( after.counters[KISS_COUNT_BATCH_CALLS] - before.counters[KISS_COUNT_BATCH_CALLS] == 1 );
+    REQUIRE( after.counters[KISS_COUNT_BATCH_ENTRIES] - before.counters[KISS_COUNT_BATCH_ENTRIES] == 10 );
+    REQUIRE( after.counters[KISS_COUNT_YEAR_LOOP_ITERATIONS] > before.counters[KISS_COUNT_YEAR_LOOP_ITERATIONS] );
+
+    REQUIRE( histogram_total(after, KISS_TIMER_CALENDAR_TO_POSIX) - histogram_total(before, KISS_TIMER_CALENDAR_TO_POSIX) == 1 );
+    REQUIRE( histogram_total(after, KISS_TIMER_POSIX_TO_CALENDAR) - histogram_total(before, KISS_TIMER_POSIX_TO_CALENDAR) == 3 );
+    REQUIRE( histogram_total(after, KISS_TIMER_PRINT_ISO) - histogram_total(before, KISS_TIMER_PRINT_ISO) == 1 );
+}
+
+TEST_CASE("instrumentation_backends"){
+    // the backend table holds the plain implementations, before and after a backend is chosen
+    kiss_instrumentation_snapshot before;
+    kiss_instrumentation_snapshot after;
+    kiss_calendar_time calendar {2021, 12, 6, 12, 53, 27};
+
+    instrumentation_snapshot(&before);
+    backend_posix_to_calendar(backend_calendar_to_posix(&calendar), &calendar);
+    instrumentation_snapshot(&after);
+    REQUIRE( after.counters[KISS_COUNT_CALENDAR_TO_POSIX] == before.counters[KISS_COUNT_CALENDAR_TO_POSIX] );
+    REQUIRE( after.counters[KISS_COUNT_POSIX_TO_CALENDAR] == before.counters[KISS_COUNT_POSIX_TO_CALENDAR] );
+
+    REQUIRE( backend_select(KISS_BACKEND_ERA, KISS_BACKEND_ERA) );
+    instrumentation_snapshot(&before);
+    backend_posix_to_calendar(backend_calendar_to_posix(&calendar), &calendar);
+    instrumentation_snapshot(&after);
+    REQUIRE( after.counters[KISS_COUNT_CALENDAR_TO_POSIX] == before.counters[KISS_COUNT_CALENDAR_TO_POSIX] );
+    REQUIRE( after.counters[KISS_COUNT_POSIX_TO_CALENDAR] == before.counters[KISS_COUNT_POSIX_TO_CALENDAR] );
+    REQUIRE( calendar.year == 2021 );
+    REQUIRE( calendar.second == 27 );
+
+    // back to the defaults
+    uint8_t const default_backend = USE_JR_IMPLEMENTATION ? KISS_BACKEND_JR : KISS_BACKEND_ORYX;
+    REQUIRE( backend_select(default_backend, default_backend) );
+}
+
+TEST_CASE("instrumentation_threads"){
+    size_t const n_threads = 4;
+    size_t const n_calls = 10000;
+
+    kiss_instrumentation_snapshot before;
+    kiss_instrumentation_snapshot after;
+    instrumentation_snapshot(&before);
+
+    // the threads wait for each other before exiting, so that they are all alive at the same time
+    std::atomic<size_t> n_done {0};
+    std::vector<std::thread> threads;
+    for (size_t i=0; i<n_threads; i++){
+        threads.emplace_back([&n_done](){
+            kiss_calendar_time calendar;
+            for (kiss_time_t j=0; j<n_calls; j++){
+                posix_to_calendar(j * 7919, &calendar);
+            }
+            n_done++;
+            while (n_done.load() < n_threads){
+                std::this_thread::yield();
+            }
+        });
+    }
+    // snapshots while the threads count are fine
+    kiss_instrumentation_snapshot during;
+    instrumentation_snapshot(&during);
+    for (std::thread &thread : threads){
+        thread.join();
+    }
+
+    instrumentation_snapshot(&after);
+    REQUIRE( after.counters[KISS_COUNT_POSIX_TO_CALENDAR] - before.counters[KISS_COUNT_POSIX_TO_CALENDAR] == n_threads * n_calls );
+    REQUIRE( after.n_blocks >= n_threads );
+
+    // the blocks of the exited threads are reused, and their counts are kept
+    size_t const n_blocks = after.n_blocks;
+    for (size_t i=0; i<8; i++){
+        std::thread thread([](){
+            kiss_calendar_time calendar;
+            posix_to_calendar(0, &calendar);
+        });
+        thread.join();
+    }
+    instrumentation_snapshot(&after);
+    REQUIRE( after.n_blocks == n_blocks );
+    REQUIRE( after.counters[KISS_COUNT_POSIX_TO_CALENDAR] - before.counters[KISS_COUNT_POSIX_TO_CALENDAR] == n_threads * n_calls + 8 );
+}
+
+TEST_CASE("instrumentation_names"){
+    REQUIRE( std::string(instrumentation_counter_name(KISS_COUNT_YEAR_LOOP_ITERATIONS)) == "year_loop_iterations" );
+    REQUIRE( std::string(instrumentation_counter_name(KISS_N_INSTRUMENTATION_COUNTERS)) == "unknown" );
+    REQUIRE( std::string(instrumentation_timer_name(KISS_TIMER_PRINT_ISO)) == "print_iso" );
+}
+
+#endif
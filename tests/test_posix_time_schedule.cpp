@@ -0,0 +1,266 @@
+#include "catch.hpp"
+#include "../src/kiss_posix_time_utils.hpp"
+#include "../src/kiss_posix_time_schedule.hpp"
+
+kiss_time_t posix_from_fields(uint16_t const year, uint8_t const month, uint8_t const day,
+                              uint8_t const hour, uint8_t const minute, uint8_t const second){
+    kiss_calendar_time working_calendar {year, month, day, hour, minute, second};
+    return calendar_to_posix(&working_calendar);
+}
+
+TEST_CASE("schedule_every_n_seconds"){
+    kiss_schedule_iterator iterator;
+    kiss_time_t start = posix_from_fields(2021, 12, 31, 23, 59, 0);
+
+    REQUIRE( schedule_init_every_n_seconds(&iterator, start, 30) );
+    REQUIRE( schedule_next(&iterator) == start );
+    REQUIRE( schedule_next(&iterator) == start + 30 );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2022, 1, 1, 0, 0, 0) );
+
+    kiss_time_t filled[4];
+    schedule_fill(&iterator, filled, 4);
+    for (size_t i=0; i<4; i++){
+        REQUIRE( filled[i] == start + 90 + 30 * i );
+    }
+    REQUIRE( schedule_next(&iterator) == start + 210 );
+}
+
+TEST_CASE("schedule_daily"){
+    kiss_schedule_iterator iterator;
+
+    // start before the time of day: first occurrence is the same day
+    REQUIRE( schedule_init_daily(&iterator, posix_from_fields(2020, 2, 28, 1, 0, 0), 2, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2020, 2, 28, 2, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2020, 2, 29, 2, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2020, 3, 1, 2, 0, 0) );
+
+    // start after the time of day: first occurrence is the next day
+    REQUIRE( schedule_init_daily(&iterator, posix_from_fields(2021, 12, 31, 2, 0, 1), 2, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2022, 1, 1, 2, 0, 0) );
+
+    // start exactly at the time of day
+    REQUIRE( schedule_init_daily(&iterator, posix_from_fields(2021, 6, 3, 2, 0, 0), 2, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2021, 6, 3, 2, 0, 0) );
+}
+
+TEST_CASE("schedule_monthly_on_day"){
+    kiss_schedule_iterator iterator;
+
+    // the 31st: months without a 31st are skipped
+    REQUIRE( schedule_init_monthly_on_day(&iterator, posix_from_fields(2021, 1, 31, 12, 0, 0), 31, 6, 30, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2021, 3, 31, 6, 30, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2021, 5, 31, 6, 30, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2021, 7, 31, 6, 30, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2021, 8, 31, 6, 30, 0) );
+
+    // the 29th: only february in leap years
+    REQUIRE( schedule_init_monthly_on_day(&iterator, posix_from_fields(2099, 12, 1, 0, 0, 0), 29, 0, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2099, 12, 29, 0, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2100, 1, 29, 0, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2100, 3, 29, 0, 0, 0) );
+}
+
+TEST_CASE("schedule_monthly_last_day"){
+    kiss_schedule_iterator iterator;
+
+    REQUIRE( schedule_init_monthly_last_day(&iterator, posix_from_fields(2019, 12, 15, 0, 0, 0), 23, 59, 59) );
+    kiss_time_t filled[5];
+    schedule_fill(&iterator, filled, 5);
+    REQUIRE( filled[0] == posix_from_fields(2019, 12, 31, 23, 59, 59) );
+    REQUIRE( filled[1] == posix_from_fields(2020, 1, 31, 23, 59, 59) );
+    REQUIRE( filled[2] == posix_from_fields(2020, 2, 29, 23, 59, 59) );
+    REQUIRE( filled[3] == posix_from_fields(2020, 3, 31, 23, 59, 59) );
+    REQUIRE( filled[4] == posix_from_fields(2020, 4, 30, 23, 59, 59) );
+}
+
+TEST_CASE("schedule_monthly_nth_week_day"){
+    kiss_schedule_iterator iterator;
+
+    // first monday of each month
+    REQUIRE( schedule_init_monthly_nth_week_day(&iterator, posix_from_fields(2021, 1, 1, 0, 0, 0), 1, 1, 9, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2021, 1, 4, 9, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2021, 2, 1, 9, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2021, 3, 1, 9, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2021, 4, 5, 9, 0, 0) );
+
+    // fifth sunday of each month: only some months have one
+    REQUIRE( schedule_init_monthly_nth_week_day(&iterator, posix_from_fields(2021, 1, 1, 0, 0, 0), 5, 7, 0, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2021, 1, 31, 0, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2021, 5, 30, 0, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2021, 8, 29, 0, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(2021, 10, 31, 0, 0, 0) );
+}
+
+TEST_CASE("schedule_monthly_against_calendar"){
+    // the carried forward state must agree with a full calendar conversion over many years
+    kiss_schedule_iterator iterator;
+    kiss_calendar_time working_calendar;
+
+    REQUIRE( schedule_init_monthly_last_day(&iterator, 0, 12, 0, 0) );
+    for (size_t i=0; i<12*500; i++){
+        kiss_time_t occurrence = schedule_next(&iterator);
+        posix_to_calendar(occurrence, &working_calendar);
+        REQUIRE( working_calendar.hour == 12 );
+        posix_to_calendar(occurrence + SECS_PER_DAY, &working_calendar);
+        REQUIRE( working_calendar.day == 1 );
+    }
+}
+
+TEST_CASE("schedule_init_out_of_range"){
+    // out of range arguments are rejected, and the iterator is left as it was
+    kiss_schedule_iterator iterator;
+    REQUIRE( schedule_init_every_n_seconds(&iterator, 0, 60) );
+    kiss_time_t const first_occurrence = iterator.next_occurrence;
+
+    REQUIRE( !schedule_init_every_n_seconds(&iterator, 100, 0) );
+    REQUIRE( !schedule_init_daily(&iterator, 100, 24, 0, 0) );
+    REQUIRE( !schedule_init_daily(&iterator, 100, 0, 60, 0) );
+    REQUIRE( !schedule_init_daily(&iterator, 100, 0, 0, 60) );
+    REQUIRE( !schedule_init_monthly_on_day(&iterator, 100, 0, 0, 0, 0) );
+    REQUIRE( !schedule_init_monthly_on_day(&iterator, 100, 32, 0, 0, 0) );
+    REQUIRE( !schedule_init_monthly_on_day(&iterator, 100, 1, 24, 0, 0) );
+    REQUIRE( !schedule_init_monthly_last_day(&iterator, 100, 0, 60, 0) );
+    REQUIRE( !schedule_init_monthly_nth_week_day(&iterator, 100, 0, 1, 0, 0, 0) );
+    REQUIRE( !schedule_init_monthly_nth_week_day(&iterator, 100, 6, 1, 0, 0, 0) );
+    REQUIRE( !schedule_init_monthly_nth_week_day(&iterator, 100, 1, 0, 0, 0, 0) );
+    REQUIRE( !schedule_init_monthly_nth_week_day(&iterator, 100, 1, 8, 0, 0, 0) );
+    REQUIRE( !schedule_init_monthly_nth_week_day(&iterator, 100, 1, 1, 0, 0, 60) );
+
+    REQUIRE( iterator.kind == KISS_SCHEDULE_EVERY_N_SECONDS );
+    REQUIRE( iterator.next_occurrence == first_occurrence );
+    REQUIRE( schedule_next(&iterator) == 0 );
+
+    // the edges of the ranges are accepted
+    REQUIRE( schedule_init_monthly_on_day(&iterator, 0, 31, 23, 59, 59) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(1970, 1, 31, 23, 59, 59) );
+    REQUIRE( schedule_init_monthly_nth_week_day(&iterator, 0, 5, 7, 0, 0, 0) );
+    REQUIRE( schedule_next(&iterator) == posix_from_fields(1970, 3, 29, 0, 0, 0) );
+}
+
+TEST_CASE("cron_compile"){
+    kiss_cron_rule rule;
+
+    REQUIRE( cron_compile("* * * * *", &rule) );
+    REQUIRE( rule.minutes == 0x0FFFFFFFFFFFFFFF );
+    REQUIRE( rule.hours == 0xFFFFFF );
+    REQUIRE( rule.days == 0x7FFFFFFF );
+    REQUIRE( rule.months == 0xFFF );
+    REQUIRE( rule.week_days == 0x7F );
+    REQUIRE( rule.flags == 0 );
+
+    REQUIRE( cron_compile("  0,30 */6 1-10/3 2 0  ", &rule) );
+    REQUIRE( rule.minutes == ((1ull << 0) | (1ull << 30)) );
+    REQUIRE( rule.hours == ((1u << 0) | (1u << 6) | (1u << 12) | (1u << 18)) );
+    REQUIRE( rule.days == ((1u << 0) | (1u << 3) | (1u << 6) | (1u << 9)) );
+    REQUIRE( rule.months == (1u << 1) );
+    REQUIRE( rule.week_days == (1u << 6) );
+    REQUIRE( rule.flags == (KISS_CRON_DAYS_RESTRICTED | KISS_CRON_WEEK_DAYS_RESTRICTED) );
+
+    // 7 is also sunday, 5/15 is 5, 20, 35, 50
+    REQUIRE( cron_compile("5/15 0 * * 1-5,7", &rule) );
+    REQUIRE( rule.minutes == ((1ull << 5) | (1ull << 20) | (1ull << 35) | (1ull << 50)) );
+    REQUIRE( rule.week_days == 0x5F );
+    REQUIRE( rule.flags == KISS_CRON_WEEK_DAYS_RESTRICTED );
+
+    // invalid expressions
+    REQUIRE( !cron_compile("", &rule) );
+    REQUIRE( !cron_compile("* * * *", &rule) );
+    REQUIRE( !cron_compile("* * * * * *", &rule) );
+    REQUIRE( !cron_compile("60 * * * *", &rule) );
+    REQUIRE( !cron_compile("* 24 * * *", &rule) );
+    REQUIRE( !cron_compile("* * 0 * *", &rule) );
+    REQUIRE( !cron_compile("* * * 13 *", &rule) );
+    REQUIRE( !cron_compile("* * * * 8", &rule) );
+    REQUIRE( !cron_compile("10-5 * * * *", &rule) );
+    REQUIRE( !cron_compile("*/0 * * * *", &rule) );
+    REQUIRE( !cron_compile("1,,2 * * * *", &rule) );
+    REQUIRE( !cron_compile("* * * jan *", &rule) );
+}
+
+TEST_CASE("cron_matches"){
+    kiss_cron_rule rule;
+
+    // every week day at 02:30
+    REQUIRE( cron_compile("30 2 * * 1-5", &rule) );
+    REQUIRE( cron_matches(&rule, posix_from_fields(2021, 12, 6, 2, 30, 0)) );   // monday
+    REQUIRE( cron_matches(&rule, posix_from_fields(2021, 12, 6, 2, 30, 59)) );
+    REQUIRE( !cron_matches(&rule, posix_from_fields(2021, 12, 6, 2, 31, 0)) );
+    REQUIRE( !cron_matches(&rule, posix_from_fields(2021, 12, 5, 2, 30, 0)) );  // sunday
+
+    // the 13th, or any friday
+    REQUIRE( cron_compile("0 0 13 * 5", &rule) );
+    REQUIRE( cron_matches(&rule, posix_from_fields(2021, 12, 13, 0, 0, 0)) );   // monday 13th
+    REQUIRE( cron_matches(&rule, posix_from_fields(2021, 12, 10, 0, 0, 0)) );   // friday 10th
+    REQUIRE( !cron_matches(&rule, posix_from_fields(2021, 12, 11, 0, 0, 0)) );
+}
+
+TEST_CASE("cron_next_fire_after"){
+    kiss_cron_rule rule;
+    kiss_time_t next;
+
+    // strictly after: at a firing time, we get the next one
+    REQUIRE( cron_compile("30 2 * * 1-5", &rule) );
+    REQUIRE( cron_next_fire_after(&rule, posix_from_fields(2021, 12, 6, 2, 30, 0), &next) );
+    REQUIRE( next == posix_from_fields(2021, 12, 7, 2, 30, 0) );
+    REQUIRE( cron_next_fire_after(&rule, posix_from_fields(2021, 12, 31, 3, 0, 0), &next) );
+    REQUIRE( next == posix_from_fields(2022, 1, 3, 2, 30, 0) );
+
+    // the 29th of february, over a non leap century
+    REQUIRE( cron_compile("0 12 29 2 *", &rule) );
+    REQUIRE( cron_next_fire_after(&rule, posix_from_fields(2096, 3, 1, 0, 0, 0), &next) );
+    REQUIRE( next == posix_from_fields(2104, 2, 29, 12, 0, 0) );
+
+    // never
+    REQUIRE( cron_compile("0 0 30 2 *", &rule) );
+    REQUIRE( !cron_next_fire_after(&rule, 0, &next) );
+}
+
+TEST_CASE("cron_next_fire_after_against_matches"){
+    // compare with the naive minute by minute search
+    char const *const expressions[] = {
+        "*/7 * * * *",
+        "15 3,17 * * *",
+        "0 0 1 * *",
+        "0 9 * * 1",
+        "45 23 31 * *",
+        "0 0 13 * 5",
+        "*/20 8-10 * 3,6 2-3",
+    };
+
+    for (char const *const expression : expressions){
+        kiss_cron_rule rule;
+        REQUIRE( cron_compile(expression, &rule) );
+
+        kiss_time_t current = posix_from_fields(2023, 12, 25, 17, 3, 12);
+        for (size_t i=0; i<30; i++){
+            kiss_time_t next;
+            REQUIRE( cron_next_fire_after(&rule, current, &next) );
+
+            kiss_time_t naive = current - current % SECS_PER_MIN + SECS_PER_MIN;
+            while (!cron_matches(&rule, naive)){
+                naive += SECS_PER_MIN;
+            }
+            REQUIRE( next == naive );
+
+            current = next;
+        }
+    }
+}
+
+TEST_CASE("day_of_week_in_schedules"){
+    // the iterators and cron rules agree on week days
+    kiss_schedule_iterator iterator;
+    kiss_cron_rule rule;
+    REQUIRE( cron_compile("0 9 1-7 * *", &rule) );
+    rule.week_days = 1;
+    rule.flags = KISS_CRON_DAYS_RESTRICTED;
+
+    REQUIRE( schedule_init_monthly_nth_week_day(&iterator, posix_from_fields(2021, 1, 1, 0, 0, 0), 1, 1, 9, 0, 0) );
+    kiss_time_t current = posix_from_fields(2021, 1, 1, 0, 0, 0);
+    for (size_t i=0; i<24; i++){
+        kiss_time_t next;
+        REQUIRE( cron_next_fire_after(&rule, current, &next) );
+        REQUIRE( next == schedule_next(&iterator) );
+        current = next;
+    }
+}
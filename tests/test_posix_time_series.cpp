@@ -0,0 +1,211 @@
+#include "catch.hpp"
+#include "../src/kiss_posix_time_utils.hpp"
+#include "../src/kiss_posix_time_extras.hpp"
+#include "../src/kiss_posix_time_series.hpp"
+#include <stdlib.h>
+#include <vector>
+
+std::vector<kiss_time_t> random_posix_times(size_t const n_values){
+    std::vector<kiss_time_t> values(n_values);
+    for (size_t i=0; i<n_values; i++){
+        values[i] = static_cast<kiss_time_t>(rand()) * 3;
+    }
+    return values;
+}
+
+TEST_CASE("histograms_against_calendar"){
+    // an odd number of values, to also go through the tail of the loops
+    size_t const n_values = 100003;
+    std::vector<kiss_time_t> values = random_posix_times(n_values);
+
+    uint64_t hours[24] {};
+    uint64_t week_days[7] {};
+    uint64_t months[12] {};
+    uint64_t years[250] {};
+    histogram_hour_of_day(values.data(), n_values, hours);
+    histogram_day_of_week(values.data(), n_values, week_days);
+    histogram_month(values.data(), n_values, months);
+    histogram_year(values.data(), n_values, 1970, 250, years);
+
+    uint64_t expected_hours[24] {};
+    uint64_t expected_week_days[7] {};
+    uint64_t expected_months[12] {};
+    uint64_t expected_years[250] {};
+    for (size_t i=0; i<n_values; i++){
+        kiss_calendar_time working_calendar;
+        posix_to_calendar(values[i], &working_calendar);
+        expected_hours[working_calendar.hour]++;
+        expected_week_days[day_of_week(values[i]) - 1]++;
+        expected_months[working_calendar.month - 1]++;
+        expected_years[working_calendar.year - 1970]++;
+    }
+
+    for (size_t i=0; i<24; i++){
+        REQUIRE( hours[i] == expected_hours[i] );
+    }
+    for (size_t i=0; i<7; i++){
+        REQUIRE( week_days[i] == expected_week_days[i] );
+    }
+    for (size_t i=0; i<12; i++){
+        REQUIRE( months[i] == expected_months[i] );
+    }
+    for (size_t i=0; i<250; i++){
+        REQUIRE( years[i] == expected_years[i] );
+    }
+}
+
+TEST_CASE("histogram_year_out_of_range"){
+    kiss_calendar_time working_calendar;
+    kiss_time_t values[4];
+    working_calendar = {1999, 12, 31, 23, 59, 59};
+    values[0] = calendar_to_posix(&working_calendar);
+    working_calendar = {2000, 1, 1, 0, 0, 0};
+    values[1] = calendar_to_posix(&working_calendar);
+    working_calendar = {2001, 12, 31, 23, 59, 59};
+    values[2] = calendar_to_posix(&working_calendar);
+    working_calendar = {2002, 1, 1, 0, 0, 0};
+    values[3] = calendar_to_posix(&working_calendar);
+
+    uint64_t years[2] {};
+    histogram_year(values, 4, 2000, 2, years);
+    REQUIRE( years[0] == 1 );
+    REQUIRE( years[1] == 1 );
+}
+
+TEST_CASE("histogram_partials_merge"){
+    // the same counts whether computed in one go, or in two parts merged at the end
+    std::vector<kiss_time_t> values = random_posix_times(1001);
+
+    uint64_t all[24] {};
+    histogram_hour_of_day(values.data(), values.size(), all);
+
+    uint64_t first_part[24] {};
+    uint64_t second_part[24] {};
+    histogram_hour_of_day(values.data(), 500, first_part);
+    histogram_hour_of_day(values.data() + 500, values.size() - 500, second_part);
+    histogram_merge(first_part, second_part, 24);
+
+    for (size_t i=0; i<24; i++){
+        REQUIRE( first_part[i] == all[i] );
+    }
+}
+
+TEST_CASE("sorted_lower_bound"){
+    kiss_time_t const sorted[] = {10, 20, 20, 20, 30, 40, 50};
+
+    REQUIRE( sorted_lower_bound(sorted, 0, 10) == 0 );
+    REQUIRE( sorted_lower_bound(sorted, 7, 0) == 0 );
+    REQUIRE( sorted_lower_bound(sorted, 7, 10) == 0 );
+    REQUIRE( sorted_lower_bound(sorted, 7, 11) == 1 );
+    REQUIRE( sorted_lower_bound(sorted, 7, 20) == 1 );
+    REQUIRE( sorted_lower_bound(sorted, 7, 21) == 4 );
+    REQUIRE( sorted_lower_bound(sorted, 7, 50) == 6 );
+    REQUIRE( sorted_lower_bound(sorted, 7, 51) == 7 );
+    REQUIRE( sorted_lower_bound(sorted, 1, 10) == 0 );
+    REQUIRE( sorted_lower_bound(sorted, 1, 11) == 1 );
+}
+
+TEST_CASE("sorted_calendar_ranges"){
+    // one value every 17 minutes over a few years
+    std::vector<kiss_time_t> values;
+    kiss_calendar_time working_calendar {2022, 11, 3, 7, 0, 0};
+    kiss_calendar_time const last {2024, 2, 1, 0, 0, 0};
+    for (kiss_time_t posix = calendar_to_posix(&working_calendar); posix < calendar_to_posix(&last); posix += 17 * SECS_PER_MIN){
+        values.push_back(posix);
+    }
+
+    // compare with a naive scan
+    auto check_range = [&values](kiss_row_range const &range, auto const &in_range){
+        size_t expected_begin = values.size();
+        size_t expected_end = values.size();
+        for (size_t i=0; i<values.size(); i++){
+            kiss_calendar_time calendar;
+            posix_to_calendar(values[i], &calendar);
+            if (in_range(calendar) && expected_begin == values.size()){
+                expected_begin = i;
+            }
+            if (!in_range(calendar) && expected_begin != values.size() && expected_end == values.size()){
+                expected_end = i;
+            }
+        }
+        if (expected_begin == values.size()){
+            return range.begin == range.end;
+        }
+        return range.begin == expected_begin && range.end == expected_end;
+    };
+
+    kiss_row_range range;
+
+    sorted_range_year(values.data(), values.size(), 2023, &range);
+    REQUIRE( check_range(range, [](kiss_calendar_time const &c){ return c.year == 2023; }) );
+
+    sorted_range_month(values.data(), values.size(), 2023, 3, &range);
+    REQUIRE( check_range(range, [](kiss_calendar_time const &c){ return c.year == 2023 && c.month == 3; }) );
+
+    sorted_range_month(values.data(), values.size(), 2023, 12, &range);
+    REQUIRE( check_range(range, [](kiss_calendar_time const &c){ return c.year == 2023 && c.month == 12; }) );
+
+    sorted_range_day(values.data(), values.size(), 2024, 1, 31, &range);
+    REQUIRE( check_range(range, [](kiss_calendar_time const &c){ return c.year == 2024 && c.month == 1 && c.day == 31; }) );
+
+    sorted_range_hour(values.data(), values.size(), 2023, 6, 15, 13, &range);
+    REQUIRE( range.end - range.begin >= 3 );
+    REQUIRE( check_range(range, [](kiss_calendar_time const &c){ return c.year == 2023 && c.month == 6 && c.day == 15 && c.hour == 13; }) );
+
+    // outside of the data
+    sorted_range_year(values.data(), values.size(), 2021, &range);
+    REQUIRE( range.begin == range.end );
+    sorted_range_year(values.data(), values.size(), 2025, &range);
+    REQUIRE( range.begin == values.size() );
+    REQUIRE( range.end == values.size() );
+
+    // the last year of the calendar: the end of the range must not wrap to year 0
+    kiss_time_t last_year[4];
+    working_calendar = {65534, 12, 31, 23, 59, 59};
+    last_year[0] = calendar_to_posix(&working_calendar);
+    working_calendar = {65535, 1, 1, 0, 0, 0};
+    last_year[1] = calendar_to_posix(&working_calendar);
+    working_calendar = {65535, 12, 1, 0, 0, 0};
+    last_year[2] = calendar_to_posix(&working_calendar);
+    last_year[3] = LAST_POSIX_IN_CALENDAR_TIME;
+    sorted_range_year(last_year, 4, 65535, &range);
+    REQUIRE( range.begin == 1 );
+    REQUIRE( range.end == 4 );
+    sorted_range_month(last_year, 4, 65535, 12, &range);
+    REQUIRE( range.begin == 2 );
+    REQUIRE( range.end == 4 );
+
+    // invalid calendar fields give an empty range at the end of the rows
+    sorted_range_month(values.data(), values.size(), 2023, 0, &range);
+    REQUIRE( range.begin == values.size() );
+    REQUIRE( range.end == values.size() );
+    sorted_range_month(values.data(), values.size(), 2023, 13, &range);
+    REQUIRE( range.begin == values.size() );
+    REQUIRE( range.end == values.size() );
+    sorted_range_day(values.data(), values.size(), 2023, 1, 32, &range);
+    REQUIRE( range.begin == values.size() );
+    REQUIRE( range.end == values.size() );
+    sorted_range_day(values.data(), values.size(), 2023, 2, 29, &range);
+    REQUIRE( range.begin == values.size() );
+    REQUIRE( range.end == values.size() );
+    sorted_range_hour(values.data(), values.size(), 2023, 6, 15, 24, &range);
+    REQUIRE( range.begin == values.size() );
+    REQUIRE( range.end == values.size() );
+    sorted_range_year(values.data(), values.size(), 1969, &range);
+    REQUIRE( range.begin == values.size() );
+    REQUIRE( range.end == values.size() );
+    sorted_range_month(values.data(), values.size(), 1969, 12, &range);
+    REQUIRE( range.begin == values.size() );
+    REQUIRE( range.end == values.size() );
+
+    // bulk
+    kiss_time_t const starts[] = {values[10], values[100], 0};
+    kiss_time_t const ends[] = {values[20], values[50], 1};
+    kiss_row_range ranges[3];
+    sorted_ranges_between(values.data(), values.size(), starts, ends, 3, ranges);
+    REQUIRE( ranges[0].begin == 10 );
+    REQUIRE( ranges[0].end == 20 );
+    REQUIRE( ranges[1].begin == ranges[1].end );
+    REQUIRE( ranges[2].begin == 0 );
+    REQUIRE( ranges[2].end == 0 );
+}
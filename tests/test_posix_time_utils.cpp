@@ -1,5 +1,6 @@
 #include "catch.hpp"
 #include "../src/kiss_posix_time_utils.hpp"
+#include <vector>
 
 TEST_CASE("is_leap_year"){
     // check that lap years work fine
@@ -124,6 +125,12 @@ TEST_CASE("calendar_to_posix"){
     working_time = 1638794479;
     working_calendar = {2021, 12, 6, 12, 41, 19};
     REQUIRE( calendar_to_posix(&working_calendar) == working_time );
+
+    // the range constants
+    working_calendar = {65535, 12, 31, 23, 59, 59};
+    REQUIRE( calendar_to_posix(&working_calendar) == LAST_POSIX_IN_CALENDAR_TIME );
+    working_calendar = {10000, 1, 1, 0, 0, 0};
+    REQUIRE( calendar_to_posix(&working_calendar) == FIRST_POSIX_OF_YEAR_10000 );
 }
 
 // if we go posix_time -> calendar -> posix_time, do we get back to the same time?
@@ -165,3 +172,317 @@ TEST_CASE("random_back_and_forth_posix_calendar_posix"){
         REQUIRE( back_and_forth_is_equal(get_random_posix()) );
     }
 }
+
+TEST_CASE("batch_conversions"){
+    kiss_time_t const posix_in[] = {0, 1, 951782464, 1638795207, 6952953588};
+    kiss_calendar_time calendars[5];
+    kiss_time_t posix_out[5];
+
+    posix_to_calendar_batch(posix_in, calendars, 5);
+    calendar_to_posix_batch(calendars, posix_out, 5);
+
+    for (size_t i=0; i<5; i++){
+        kiss_calendar_time working_calendar;
+        posix_to_calendar(posix_in[i], &working_calendar);
+        REQUIRE( calendars[i].year == working_calendar.year );
+        REQUIRE( calendars[i].day == working_calendar.day );
+        REQUIRE( posix_out[i] == posix_in[i] );
+    }
+}
+
+TEST_CASE("valid_calendar_batch"){
+    kiss_calendar_time const calendars[] = {
+        {2021, 12, 3, 18, 12, 39},
+        {2021, 0, 3, 18, 12, 39},
+        {2021, 13, 3, 18, 12, 39},
+        {2021, 255, 3, 18, 12, 39},
+        {2020, 2, 29, 0, 0, 0},
+        {2021, 2, 29, 0, 0, 0},
+        {2021, 11, 12, 21, 34, 60},
+        {2021, 1, 31, 23, 59, 59},
+        {1970, 1, 1, 0, 0, 0},
+        {1970, 1, 0, 0, 0, 0},
+    };
+    uint8_t valid_mask[2];
+
+    REQUIRE( calendar_is_valid_batch(calendars, 10, valid_mask) == 4 );
+    REQUIRE( valid_mask[0] == 0x91 );
+    REQUIRE( valid_mask[1] == 0x01 );
+
+    for (size_t i=0; i<10; i++){
+        REQUIRE( calendar_is_valid(&calendars[i]) == (((valid_mask[i / 8] >> (i % 8)) & 1) == 1) );
+    }
+}
+
+TEST_CASE("calendar_to_posix_checked"){
+    kiss_calendar_time working_calendar;
+    kiss_time_t working_time {12345};
+
+    working_calendar = {2021, 12, 6, 12, 53, 27};
+    REQUIRE( calendar_to_posix_checked(&working_calendar, &working_time) == KISS_CONVERSION_OK );
+    REQUIRE( working_time == 1638795207 );
+
+    working_calendar = {2000, 2, 29, 0, 1, 4};
+    REQUIRE( calendar_to_posix_checked(&working_calendar, &working_time) == KISS_CONVERSION_OK );
+    REQUIRE( working_time == 951782464 );
+
+    // invalid calendars, the output is not touched
+    working_time = 12345;
+    working_calendar = {1969, 12, 31, 23, 59, 59};
+    REQUIRE( calendar_to_posix_checked(&working_calendar, &working_time) == KISS_CONVERSION_INVALID_YEAR );
+    working_calendar = {2021, 0, 3, 18, 12, 39};
+    REQUIRE( calendar_to_posix_checked(&working_calendar, &working_time) == KISS_CONVERSION_INVALID_MONTH );
+    working_calendar = {2021, 13, 3, 18, 12, 39};
+    REQUIRE( calendar_to_posix_checked(&working_calendar, &working_time) == KISS_CONVERSION_INVALID_MONTH );
+    working_calendar = {2021, 2, 29, 18, 12, 39};
+    REQUIRE( calendar_to_posix_checked(&working_calendar, &working_time) == KISS_CONVERSION_INVALID_DAY );
+    working_calendar = {2021, 2, 0, 18, 12, 39};
+    REQUIRE( calendar_to_posix_checked(&working_calendar, &working_time) == KISS_CONVERSION_INVALID_DAY );
+    working_calendar = {2021, 2, 3, 24, 12, 39};
+    REQUIRE( calendar_to_posix_checked(&working_calendar, &working_time) == KISS_CONVERSION_INVALID_HOUR );
+    working_calendar = {2021, 2, 3, 18, 60, 39};
+    REQUIRE( calendar_to_posix_checked(&working_calendar, &working_time) == KISS_CONVERSION_INVALID_MINUTE );
+    working_calendar = {2021, 2, 3, 18, 12, 60};
+    REQUIRE( calendar_to_posix_checked(&working_calendar, &working_time) == KISS_CONVERSION_INVALID_SECOND );
+    REQUIRE( working_time == 12345 );
+
+    // same results as the unchecked conversion on valid calendars
+    for (size_t i=0; i<100000; i++){
+        kiss_time_t const posix_in = get_random_posix() * 7;
+        posix_to_calendar(posix_in, &working_calendar);
+        REQUIRE( calendar_to_posix_checked(&working_calendar, &working_time) == KISS_CONVERSION_OK );
+        REQUIRE( working_time == posix_in );
+    }
+}
+
+TEST_CASE("calendar_to_posix_checked_batch"){
+    kiss_calendar_time const calendars[] = {
+        {2021, 12, 6, 12, 53, 27},
+        {2021, 0, 3, 18, 12, 39},
+        {1969, 12, 31, 23, 59, 59},
+        {2000, 2, 29, 0, 1, 4},
+        {2021, 2, 29, 0, 0, 0},
+        {1970, 1, 1, 0, 0, 1},
+        {2021, 11, 12, 21, 34, 60},
+        {2021, 12, 31, 23, 59, 59},
+        {2021, 14, 31, 23, 59, 59},
+    };
+    kiss_time_t posix_out[9];
+    uint8_t valid_mask[2];
+
+    REQUIRE( calendar_to_posix_checked_batch(calendars, posix_out, 9, valid_mask) == 4 );
+    REQUIRE( valid_mask[0] == 0xA9 );
+    REQUIRE( valid_mask[1] == 0x00 );
+    REQUIRE( posix_out[0] == 1638795207 );
+    REQUIRE( posix_out[1] == 0 );
+    REQUIRE( posix_out[3] == 951782464 );
+    REQUIRE( posix_out[5] == 1 );
+    REQUIRE( posix_out[7] == 1640995199 );
+    REQUIRE( posix_out[8] == 0 );
+}
+
+TEST_CASE("wide_calendar"){
+    kiss_wide_calendar_time wide_calendar;
+    kiss_calendar_time working_calendar;
+    kiss_time_t working_time;
+
+    // same as the usual calendar where both work
+    for (size_t i=0; i<100000; i++){
+        kiss_time_t const posix_in = get_random_posix() * 911;
+        posix_to_calendar(posix_in, &working_calendar);
+        posix_to_wide_calendar(posix_in, &wide_calendar);
+        REQUIRE( wide_calendar.year == working_calendar.year );
+        REQUIRE( wide_calendar.month == working_calendar.month );
+        REQUIRE( wide_calendar.day == working_calendar.day );
+        REQUIRE( wide_calendar.hour == working_calendar.hour );
+        REQUIRE( wide_calendar.minute == working_calendar.minute );
+        REQUIRE( wide_calendar.second == working_calendar.second );
+        REQUIRE( wide_calendar_to_posix(&wide_calendar, &working_time) );
+        REQUIRE( working_time == posix_in );
+    }
+
+    // after year 65535
+    wide_calendar = {65536, 1, 1, 0, 0, 0};
+    REQUIRE( wide_calendar_to_posix(&wide_calendar, &working_time) );
+    REQUIRE( working_time == 2005949145600 );
+    posix_to_wide_calendar(working_time - 1, &wide_calendar);
+    REQUIRE( wide_calendar.year == 65535 );
+    REQUIRE( wide_calendar.month == 12 );
+    REQUIRE( wide_calendar.day == 31 );
+    REQUIRE( wide_calendar.second == 59 );
+
+    // the very end of kiss_time_t
+    posix_to_wide_calendar(0xFFFFFFFFFFFFFFFF, &wide_calendar);
+    REQUIRE( wide_calendar.year == 584554051223 );
+    REQUIRE( wide_calendar.month == 11 );
+    REQUIRE( wide_calendar.day == 9 );
+    REQUIRE( wide_calendar.hour == 7 );
+    REQUIRE( wide_calendar.minute == 0 );
+    REQUIRE( wide_calendar.second == 15 );
+    REQUIRE( wide_calendar_to_posix(&wide_calendar, &working_time) );
+    REQUIRE( working_time == 0xFFFFFFFFFFFFFFFF );
+
+    // out of range
+    wide_calendar.second = 16;
+    REQUIRE( !wide_calendar_to_posix(&wide_calendar, &working_time) );
+    wide_calendar = {584554051224, 1, 1, 0, 0, 0};
+    REQUIRE( !wide_calendar_to_posix(&wide_calendar, &working_time) );
+    wide_calendar = {1969, 12, 31, 23, 59, 59};
+    REQUIRE( !wide_calendar_to_posix(&wide_calendar, &working_time) );
+    wide_calendar = {-5, 1, 1, 0, 0, 0};
+    REQUIRE( !wide_calendar_to_posix(&wide_calendar, &working_time) );
+}
+
+TEST_CASE("calendar_advance"){
+    kiss_calendar_time working_calendar;
+    kiss_calendar_time expected_calendar;
+
+    // steps of all sizes, from random starts, against the conversions through posix time
+    uint64_t random_state {0x9E3779B97F4A7C15};
+    kiss_time_t const max_steps[] = {60, 3600, SECS_PER_DAY, 40 * SECS_PER_DAY, 366 * SECS_PER_DAY, 367 * SECS_PER_DAY, 1000 * SECS_PER_YEAR};
+    for (kiss_time_t max_step : max_steps){
+        for (size_t i=0; i<20000; i++){
+            random_state ^= random_state << 13;
+            random_state ^= random_state >> 7;
+            random_state ^= random_state << 17;
+            kiss_time_t const start = random_state % 4102444800;
+            kiss_time_t const step = (random_state >> 20) % (max_step + 1);
+
+            posix_to_calendar(start, &working_calendar);
+            posix_to_calendar(start + step, &expected_calendar);
+            REQUIRE( calendar_advance_seconds(&working_calendar, step) );
+            REQUIRE( calendar_to_posix(&working_calendar) == start + step );
+            REQUIRE( working_calendar.year == expected_calendar.year );
+            REQUIRE( working_calendar.month == expected_calendar.month );
+            REQUIRE( working_calendar.day == expected_calendar.day );
+            REQUIRE( working_calendar.hour == expected_calendar.hour );
+            REQUIRE( working_calendar.minute == expected_calendar.minute );
+            REQUIRE( working_calendar.second == expected_calendar.second );
+        }
+    }
+
+    // over a leap day
+    working_calendar = {2020, 2, 28, 23, 59, 59};
+    REQUIRE( calendar_advance_seconds(&working_calendar, 1) );
+    REQUIRE( working_calendar.month == 2 );
+    REQUIRE( working_calendar.day == 29 );
+    REQUIRE( calendar_advance_seconds(&working_calendar, SECS_PER_DAY) );
+    REQUIRE( working_calendar.month == 3 );
+    REQUIRE( working_calendar.day == 1 );
+
+    // the end of kiss_calendar_time, with both the short and the long steps; nothing is changed on failure
+    kiss_calendar_time const last_calendar {65535, 12, 31, 23, 59, 59};
+    working_calendar = last_calendar;
+    REQUIRE( calendar_advance_seconds(&working_calendar, 0) );
+    REQUIRE( !calendar_advance_seconds(&working_calendar, 1) );
+    REQUIRE( !calendar_advance_seconds(&working_calendar, 1000 * SECS_PER_DAY) );
+    REQUIRE( !calendar_advance_seconds(&working_calendar, 0xFFFFFFFFFFFFFFFF) );
+    REQUIRE( calendar_to_posix(&working_calendar) == calendar_to_posix(&last_calendar) );
+    working_calendar = {65535, 12, 31, 23, 59, 58};
+    REQUIRE( calendar_advance_seconds(&working_calendar, 1) );
+    REQUIRE( working_calendar.second == 59 );
+}
+
+TEST_CASE("calendar_fill_steps"){
+    kiss_calendar_time const start {2021, 12, 31, 23, 0, 0};
+    kiss_calendar_time series[1000];
+    kiss_calendar_time expected_calendar;
+
+    kiss_time_t const steps[] = {0, 1, 15 * SECS_PER_MIN, SECS_PER_DAY + 7, 500 * SECS_PER_DAY};
+    for (kiss_time_t step : steps){
+        REQUIRE( calendar_fill_steps(&start, step, series, 1000) == 1000 );
+        for (size_t i=0; i<1000; i++){
+            posix_to_calendar(calendar_to_posix(&start) + i * step, &expected_calendar);
+            REQUIRE( calendar_to_posix(&series[i]) == calendar_to_posix(&expected_calendar) );
+            REQUIRE( calendar_is_valid(&series[i]) );
+        }
+    }
+
+    // a series that goes past the end of kiss_calendar_time stops there
+    kiss_calendar_time const late_start {65535, 12, 31, 23, 59, 55};
+    REQUIRE( calendar_fill_steps(&late_start, 2, series, 1000) == 3 );
+    REQUIRE( series[2].second == 59 );
+    REQUIRE( calendar_fill_steps(&late_start, 2, series, 0) == 0 );
+}
+
+TEST_CASE("julian_day_numbers"){
+    // 2000-01-01T12:00:00 is Julian Date 2451545.0, i.e. JDN 2451545 and MJD 51544.5
+    REQUIRE( posix_to_julian_day_number(946728000) == 2451545 );
+    REQUIRE( posix_to_modified_julian_day(946728000) == 51544 );
+    REQUIRE( posix_to_julian_day_number(0) == JULIAN_DAY_NUMBER_OF_EPOCH );
+    REQUIRE( posix_to_modified_julian_day(86399) == MODIFIED_JULIAN_DAY_OF_EPOCH );
+    REQUIRE( posix_to_modified_julian_day(86400) == MODIFIED_JULIAN_DAY_OF_EPOCH + 1 );
+
+    kiss_time_t posix {42};
+    REQUIRE( julian_day_number_to_posix(2451545, &posix) );
+    REQUIRE( posix == 946684800 );
+    REQUIRE( modified_julian_day_to_posix(51544, &posix) );
+    REQUIRE( posix == 946684800 );
+    REQUIRE( modified_julian_day_to_posix(MODIFIED_JULIAN_DAY_OF_EPOCH, &posix) );
+    REQUIRE( posix == 0 );
+
+    // before the epoch, or after the end of kiss_time_t
+    posix = 42;
+    REQUIRE( !julian_day_number_to_posix(JULIAN_DAY_NUMBER_OF_EPOCH - 1, &posix) );
+    REQUIRE( !modified_julian_day_to_posix(0, &posix) );
+    REQUIRE( !modified_julian_day_to_posix(UINT64_MAX, &posix) );
+    REQUIRE( posix == 42 );
+    REQUIRE( modified_julian_day_to_posix(posix_to_modified_julian_day(UINT64_MAX), &posix) );
+    REQUIRE( posix == UINT64_MAX - UINT64_MAX % SECS_PER_DAY );
+
+    kiss_time_t const posix_in[] = {0, 946728000, 1638795207};
+    kiss_time_t julian_day_numbers[3];
+    kiss_time_t modified_julian_days[3];
+    posix_to_julian_day_number_batch(posix_in, julian_day_numbers, 3);
+    posix_to_modified_julian_day_batch(posix_in, modified_julian_days, 3);
+    for (size_t i=0; i<3; i++){
+        REQUIRE( julian_day_numbers[i] == posix_to_julian_day_number(posix_in[i]) );
+        REQUIRE( modified_julian_days[i] == posix_to_modified_julian_day(posix_in[i]) );
+        REQUIRE( julian_day_numbers[i] - modified_julian_days[i] == 2400001 );
+    }
+}
+
+TEST_CASE("ordinal_dates"){
+    kiss_ordinal_date ordinal;
+    posix_to_ordinal(0, &ordinal);
+    REQUIRE( ordinal.year == 1970 );
+    REQUIRE( ordinal.day_of_year == 1 );
+    posix_to_ordinal(1609459199, &ordinal);    // 2020-12-31T23:59:59
+    REQUIRE( ordinal.year == 2020 );
+    REQUIRE( ordinal.day_of_year == 366 );
+    posix_to_ordinal(2005949145599, &ordinal);
+    REQUIRE( ordinal.year == 65535 );
+    REQUIRE( ordinal.day_of_year == 365 );
+
+    kiss_time_t posix {42};
+    kiss_ordinal_date invalid {2021, 366};
+    REQUIRE( !ordinal_to_posix(&invalid, &posix) );
+    invalid = kiss_ordinal_date {2021, 0};
+    REQUIRE( !ordinal_to_posix(&invalid, &posix) );
+    invalid = kiss_ordinal_date {1969, 1};
+    REQUIRE( !ordinal_to_posix(&invalid, &posix) );
+    REQUIRE( posix == 42 );
+
+    // the same as through the calendar, and back to the start of the day, over the whole range
+    kiss_time_t const step = 86400 * 7 + 3607;
+    std::vector<kiss_time_t> posix_in;
+    for (kiss_time_t time=0; time<=2005949145599; time+=step * 101){
+        posix_in.push_back(time);
+    }
+    for (kiss_time_t time=946684800 - 3 * 86400; time<946684800 + 800 * 86400; time+=43200){
+        posix_in.push_back(time);
+    }
+    std::vector<kiss_ordinal_date> ordinals(posix_in.size());
+    posix_to_ordinal_batch(posix_in.data(), ordinals.data(), posix_in.size());
+
+    for (size_t i=0; i<posix_in.size(); i++){
+        kiss_calendar_time calendar;
+        posix_to_calendar(posix_in[i], &calendar);
+        uint16_t const *const cumulative_days = is_leap_year(calendar.year) ? cumulative_days_per_month_leap : cumulative_days_per_month_normal;
+        REQUIRE( ordinals[i].year == calendar.year );
+        REQUIRE( ordinals[i].day_of_year == cumulative_days[calendar.month - 1] + calendar.day );
+
+        REQUIRE( ordinal_to_posix(&ordinals[i], &posix) );
+        REQUIRE( posix == posix_in[i] - posix_in[i] % SECS_PER_DAY );
+    }
+}